@@ -0,0 +1,265 @@
+/**
+ * @file    actuator.hpp
+ * @brief   Optional C++ front end with the pin map fixed at compile time.
+ *
+ * Wraps the C state machine (#ActuatorControl_t) unchanged; only the GPIO
+ * access moves into the template. Ports, pin masks and active levels are
+ * template arguments, so reading the limit switches is one constant-address
+ * IDR load per port and an output change is one constant BSRR store per
+ * port — no `void*` dereference, no per-pin loop. The switch levels are
+ * passed to actuator_update_raw() and the outputs are taken back through
+ * the deferred-output interface, exactly as #ActuatorGroup_t does.
+ *
+ * The board of this repository:
+ *
+ * @code
+ * typedef actuator::Actuator<actuator::Pin<actuator::PortB, 0U>,   // extend relay
+ *                            actuator::Pin<actuator::PortB, 1U>,   // shrink relay
+ *                            actuator::Pin<actuator::PortB, 7U>,   // extend switch
+ *                            actuator::Pin<actuator::PortB, 8U>,   // shrink switch
+ *                            actuator::Pin<actuator::PortB, 5U>,   // extend LED
+ *                            actuator::Pin<actuator::PortB, 6U> >  // shrink LED
+ *         BoardActuator;
+ *
+ * static BoardActuator s_actuator;
+ * s_actuator.init(MS_TO_TICKS(DEBOUNCE_TIME_MS), MS_TO_TICKS(HOMING_TIMEOUT_MS));
+ * s_actuator.update(HAL_GetTick());
+ * @endcode
+ *
+ * The C API stays the primary interface; this header is only for C++
+ * translation units (C++11 or later).
+ */
+
+#ifndef ACTUATOR_HPP
+#define ACTUATOR_HPP
+
+#include <stdint.h>
+#include <type_traits>
+
+#include "actuator_control.h"
+#include "stm32f1xx_hal.h"          /* GPIO_TypeDef, GPIOx */
+
+namespace actuator {
+
+/* -------------------------------------------------------------------------- */
+/*   Ports and pins                                                           */
+/* -------------------------------------------------------------------------- */
+
+/** A GPIO port type; `regs()` folds to the peripheral address. */
+#define ACTUATOR_GPIO_PORT(name, gpio)                                      \
+    struct name {                                                           \
+        static GPIO_TypeDef *regs() { return gpio; }                        \
+    }
+
+ACTUATOR_GPIO_PORT(PortA, GPIOA);
+ACTUATOR_GPIO_PORT(PortB, GPIOB);
+ACTUATOR_GPIO_PORT(PortC, GPIOC);
+ACTUATOR_GPIO_PORT(PortD, GPIOD);
+
+#undef ACTUATOR_GPIO_PORT
+
+/** Pin `N` (0..15) of port `PortT`. */
+template <typename PortT, unsigned N>
+struct Pin {
+    static_assert(N < 16U, "GPIO pin number out of range");
+
+    typedef PortT port;
+    static constexpr uint16_t mask = (uint16_t)(1U << N);
+};
+
+/** Non-zero if pins `A` and `B` are the same physical pin. */
+template <typename A, typename B>
+struct same_pin {
+    static constexpr bool value = std::is_same<typename A::port, typename B::port>::value &&
+                                  (A::mask == B::mask);
+};
+
+/* -------------------------------------------------------------------------- */
+/*   Actuator                                                                 */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  One actuator with a compile-time pin map.
+ *
+ * @tparam ExtendOut     Extend relay output.
+ * @tparam ShrinkOut     Shrink relay output.
+ * @tparam ExtendSwitch  Extend limit switch input.
+ * @tparam ShrinkSwitch  Shrink limit switch input.
+ * @tparam LedExtend     Extend-direction LED output.
+ * @tparam LedShrink     Shrink-direction LED output.
+ * @tparam ExtendActive  Level of the extend relay and switch when active.
+ * @tparam ShrinkActive  Level of the shrink relay and switch when active.
+ */
+template <typename ExtendOut, typename ShrinkOut,
+          typename ExtendSwitch, typename ShrinkSwitch,
+          typename LedExtend, typename LedShrink,
+          uint8_t ExtendActive = GPIO_PIN_SET, uint8_t ShrinkActive = GPIO_PIN_SET>
+class Actuator {
+    static_assert(!same_pin<ExtendOut, ShrinkOut>::value &&
+                  !same_pin<ExtendOut, LedExtend>::value &&
+                  !same_pin<ExtendOut, LedShrink>::value &&
+                  !same_pin<ShrinkOut, LedExtend>::value &&
+                  !same_pin<ShrinkOut, LedShrink>::value &&
+                  !same_pin<LedExtend, LedShrink>::value,
+                  "actuator outputs must use distinct pins");
+    static_assert(!same_pin<ExtendSwitch, ShrinkSwitch>::value,
+                  "limit switches must use distinct pins");
+
+public:
+    /**
+     * @brief  Initialise the state machine; see #actuator_init().
+     * @param  debounce_ticks       Switch debounce window in ticks.
+     * @param  homing_timeout_ticks Homing safety timeout per phase in ticks.
+     * @param  switch_edge_wakeup   Non-zero if every switch edge triggers an update.
+     * @param  timestamp_us         Microsecond clock for edge-timed travel, or NULL.
+     * @param  encoder_count        Encoder count for closed-loop positioning, or NULL.
+     */
+    void init(uint32_t debounce_ticks, uint32_t homing_timeout_ticks, uint8_t switch_edge_wakeup = 0U,
+              uint32_t (*timestamp_us)(void) = NULL, int32_t (*encoder_count)(void) = NULL)
+    {
+        ActuatorConfig_t cfg = ActuatorConfig_t();
+
+        cfg.extend_active_level = ExtendActive;
+        cfg.shrink_active_level = ShrinkActive;
+        cfg.debounce_time_ms    = debounce_ticks;
+        cfg.homing_timeout_ms   = homing_timeout_ticks;
+        cfg.homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT;
+        cfg.relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS);
+        cfg.stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS);
+        cfg.park_position       = ACTUATOR_PARK_POSITION;
+        cfg.switch_edge_wakeup  = switch_edge_wakeup;
+        cfg.timestamp_us        = timestamp_us;
+        cfg.encoder_count       = encoder_count;
+
+        /* Still needed by actuator_limit_switch_isr(), which runs in C */
+        cfg.extend_control_port = (void*)ExtendOut::port::regs();
+        cfg.extend_control_pin  = ExtendOut::mask;
+        cfg.shrink_control_port = (void*)ShrinkOut::port::regs();
+        cfg.shrink_control_pin  = ShrinkOut::mask;
+        cfg.extend_switch_port  = (void*)ExtendSwitch::port::regs();
+        cfg.extend_switch_pin   = ExtendSwitch::mask;
+        cfg.shrink_switch_port  = (void*)ShrinkSwitch::port::regs();
+        cfg.shrink_switch_pin   = ShrinkSwitch::mask;
+        cfg.led_extend_port     = (void*)LedExtend::port::regs();
+        cfg.led_extend_pin      = LedExtend::mask;
+        cfg.led_shrink_port     = (void*)LedShrink::port::regs();
+        cfg.led_shrink_pin      = LedShrink::mask;
+
+        actuator_init(&m_act, &cfg);
+        actuator_defer_outputs(&m_act, 1U);
+    }
+
+    /**
+     * @brief  Read both switches, run the state machine, write the outputs
+     *         if they changed; see #actuator_update().
+     */
+    void update(uint32_t current_time)
+    {
+        const uint32_t extend_idr = ExtendSwitch::port::regs()->IDR;
+        const uint32_t shrink_idr = same_switch_port ? extend_idr : ShrinkSwitch::port::regs()->IDR;
+
+        actuator_update_raw(&m_act,
+                            (uint8_t)((extend_idr & ExtendSwitch::mask) != 0U),
+                            (uint8_t)((shrink_idr & ShrinkSwitch::mask) != 0U),
+                            current_time);
+
+        ActuatorOutput_t output;
+        if ((m_act.output_dirty != 0U) && (actuator_take_output(&m_act, &output) != 0U)) {
+            write(output);
+        }
+    }
+
+    void     extend()                            { actuator_extend(&m_act); }
+    void     shrink()                            { actuator_shrink(&m_act); }
+    void     stop()                              { actuator_stop(&m_act); }
+    void     start_homing()                      { actuator_start_homing(&m_act); }
+    void     move_to(uint16_t permille)          { actuator_move_to(&m_act, permille); }
+    uint8_t  post(const ActuatorCommand_t &cmd)  { return actuator_post(&m_act, &cmd); }
+    void     limit_switch_isr(uint16_t gpio_pin) { actuator_limit_switch_isr(&m_act, gpio_pin); }
+    void     switch_edge(uint16_t gpio_pin, uint32_t timestamp_us)
+    {
+        actuator_switch_edge(&m_act, gpio_pin, timestamp_us);
+    }
+
+    ActuatorState_t state() const                { return actuator_get_state(&m_act); }
+    uint8_t         is_homing() const            { return actuator_is_homing(&m_act); }
+    uint8_t         is_error() const             { return actuator_is_error(&m_act); }
+    uint8_t         is_calibrated() const        { return actuator_is_calibrated(&m_act); }
+    uint16_t        position() const             { return actuator_get_position(&m_act); }
+    int32_t         position_counts() const      { return actuator_get_position_counts(&m_act); }
+
+    uint32_t next_deadline(uint32_t current_time) const
+    {
+        return actuator_next_deadline(&m_act, current_time);
+    }
+
+    /** The underlying C structure, for the rest of the C API. */
+    ActuatorControl_t       &control()       { return m_act; }
+    const ActuatorControl_t &control() const { return m_act; }
+
+private:
+    static constexpr bool same_switch_port =
+        std::is_same<typename ExtendSwitch::port, typename ShrinkSwitch::port>::value;
+
+    /** BSRR half-word pair for pin `P` at `level`: low half sets, high half resets. */
+    template <typename P>
+    static constexpr uint32_t pin_word(bool level)
+    {
+        return level ? (uint32_t)P::mask : ((uint32_t)P::mask << 16U);
+    }
+
+    /** Contribution of pin `P` to the BSRR word of port `PortT`. */
+    template <typename PortT, typename P>
+    static constexpr uint32_t on_port(bool level)
+    {
+        return std::is_same<PortT, typename P::port>::value ? pin_word<P>(level) : 0U;
+    }
+
+    /** Complete BSRR word of port `PortT` for one output pattern. */
+    template <typename PortT>
+    static constexpr uint32_t port_word(ActuatorOutput_t output)
+    {
+        return on_port<PortT, ExtendOut>((output == ACTUATOR_OUTPUT_EXTEND) ? (ExtendActive != 0U)
+                                                                           : (ExtendActive == 0U)) |
+               on_port<PortT, ShrinkOut>((output == ACTUATOR_OUTPUT_SHRINK) ? (ShrinkActive != 0U)
+                                                                           : (ShrinkActive == 0U)) |
+               on_port<PortT, LedExtend>(output == ACTUATOR_OUTPUT_EXTEND) |
+               on_port<PortT, LedShrink>(output == ACTUATOR_OUTPUT_SHRINK);
+    }
+
+    template <typename PortT>
+    static void store(ActuatorOutput_t output)
+    {
+        /* Three constant words; the compiler selects one and stores it */
+        PortT::regs()->BSRR = (output == ACTUATOR_OUTPUT_EXTEND) ? port_word<PortT>(ACTUATOR_OUTPUT_EXTEND)
+                            : (output == ACTUATOR_OUTPUT_SHRINK) ? port_word<PortT>(ACTUATOR_OUTPUT_SHRINK)
+                            :                                      port_word<PortT>(ACTUATOR_OUTPUT_STOP);
+    }
+
+    /** One store per distinct output port; pins on a shared port change together. */
+    static void write(ActuatorOutput_t output)
+    {
+        typedef typename ExtendOut::port P0;
+        typedef typename ShrinkOut::port P1;
+        typedef typename LedExtend::port P2;
+        typedef typename LedShrink::port P3;
+
+        store<P0>(output);
+        if (!std::is_same<P1, P0>::value) {
+            store<P1>(output);
+        }
+        if (!std::is_same<P2, P0>::value && !std::is_same<P2, P1>::value) {
+            store<P2>(output);
+        }
+        if (!std::is_same<P3, P0>::value && !std::is_same<P3, P1>::value &&
+            !std::is_same<P3, P2>::value) {
+            store<P3>(output);
+        }
+    }
+
+    ActuatorControl_t m_act;
+};
+
+} /* namespace actuator */
+
+#endif /* ACTUATOR_HPP */
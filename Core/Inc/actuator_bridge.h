@@ -0,0 +1,76 @@
+/**
+ * @file    actuator_bridge.h
+ * @brief   H-bridge motor drive on TIM1 PWM with soft start and stop ramps,
+ *          an alternative to the two relays.
+ *
+ * PA8 (TIM1_CH1) and PA11 (TIM1_CH4) drive the two inputs of an H-bridge
+ * with independent PWM inputs (IN1 / IN2 type: DRV8871, BTS7960 with the
+ * enables tied high, ...): PWM on PA8 extends, PWM on PA11 shrinks, both
+ * low is off. The PWM runs at #ACTUATOR_BRIDGE_PWM_HZ with the compare
+ * registers preloaded, and the repetition counter raises the update
+ * interrupt once every #ACTUATOR_BRIDGE_STEP_HZ. That interrupt advances
+ * the ramp (actuator_ramp.h) by one step and writes the next duty into the
+ * preload registers, which the timer applies at the following update event
+ * — glitch-free, at a period boundary. Once the ramp is done the interrupt
+ * is switched off until the next request.
+ *
+ * Pass #actuator_bridge_output() as ActuatorConfig_t::bridge_output and
+ * leave the relay control ports NULL:
+ *
+ *   - every start ramps up in `accel_ms` and every stop ramps down in
+ *     `decel_ms`, so make the relay dead time at least `decel_ms`
+ *     (a reversal then waits for the motor to come to rest), the stop
+ *     lag `decel_ms / 2` (the travel of a linear ramp-down from full speed)
+ *     and the start lag `accel_ms / 2` (the travel a ramp-up falls behind);
+ *   - within ActuatorConfig_t::approach_permille of an end stop the duty
+ *     drops to `approach_pct`, so the stroke runs at full speed and only
+ *     the last part at approach speed;
+ *   - a limit switch or a stall (#ACTUATOR_SPEED_CUT) switches both
+ *     outputs off at once, bypassing the preload.
+ *
+ * @note    Target only. Register-level set-up, like actuator_encoder.h. The
+ *          duty is never written from the main loop. DMA is not used: the
+ *          TIM1_UP request is on DMA1 channel 5, which carries USART1 RX
+ *          (uart_command.h). The timer stops in STOP mode.
+ */
+
+#ifndef ACTUATOR_BRIDGE_H
+#define ACTUATOR_BRIDGE_H
+
+#include <stdint.h>
+#include "actuator_control.h"       /* ActuatorOutput_t, ActuatorSpeed_t */
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** PWM frequency: above the audible range. */
+#define ACTUATOR_BRIDGE_PWM_HZ      20000UL
+
+/** Ramp steps per second: one update interrupt per 20 PWM periods. */
+#define ACTUATOR_BRIDGE_STEP_HZ     1000UL
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Configure PA8/PA11 and TIM1 and start the PWM with both outputs off.
+ * @param  accel_ms      Ramp from rest to full duty.
+ * @param  decel_ms      Ramp from full duty to rest.
+ * @param  approach_pct  Duty near an end stop, percent of full.
+ */
+void actuator_bridge_init(uint16_t accel_ms, uint16_t decel_ms, uint8_t approach_pct);
+
+/**
+ * @brief  Request a direction and speed — ActuatorConfig_t::bridge_output.
+ * @note   Callable from the main loop and from interrupts.
+ */
+void actuator_bridge_output(ActuatorOutput_t output, ActuatorSpeed_t speed);
+
+/**
+ * @brief  TIM1 update interrupt body — call from TIM1_UP_IRQHandler().
+ */
+void actuator_bridge_irq_handler(void);
+
+#endif /* ACTUATOR_BRIDGE_H */
@@ -0,0 +1,85 @@
+/**
+ * @file    actuator_command.h
+ * @brief   Text command parser for the actuator, reading straight from a
+ *          circular receive buffer.
+ *
+ * The parser never copies: it scans the buffer a DMA channel (or any other
+ * producer) fills, and decodes each complete line in place, following the
+ * wrap-around of the ring. One call decodes at most one line, and each byte
+ * is scanned once, so draining a burst in the idle-line ISR costs at most
+ * one buffer length. Decoded commands go to the actuator through
+ * actuator_post(), never straight into a running actuator_update().
+ *
+ * Grammar (one command per line, `\r` and/or `\n` terminated, case-insensitive):
+ *
+ *     EXTEND [n]
+ *     SHRINK [n]
+ *     STOP   [n]
+ *     HOME   [n]
+ *     MOVE <permille> [n]
+ *
+ * `n` selects the actuator (default 0).
+ *
+ * @note    HAL-agnostic; builds on the host as well as on the target.
+ */
+
+#ifndef ACTUATOR_COMMAND_H
+#define ACTUATOR_COMMAND_H
+
+#include <stdint.h>
+#include "actuator_control.h"       /* ActuatorCommand_t (actuator_queue.h) */
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Parser state over a circular buffer.
+ * @note   Positions are offsets into the buffer, 0..size-1.
+ */
+typedef struct {
+    const volatile uint8_t *p_buf;      /**< Ring written by the producer (DMA)   */
+    uint16_t                mask;       /**< size - 1; size is a power of two     */
+    uint16_t                read_pos;   /**< First byte of the current line       */
+    uint16_t                scan_pos;   /**< First byte not yet scanned           */
+} CommandParser_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Attach a parser to a ring buffer.
+ * @param  p_parser  Parser (out).
+ * @param  p_buf     Ring buffer filled by the producer.
+ * @param  size      Buffer size in bytes — must be a power of two (>= 2).
+ * @return Non-zero on success, zero if `size` is not a power of two.
+ */
+uint8_t command_parser_init(CommandParser_t *p_parser,
+                            const volatile uint8_t *p_buf,
+                            uint16_t size);
+
+/**
+ * @brief  Decode the next complete line, if any.
+ * @param  p_parser   Parser.
+ * @param  write_pos  Producer position: offset of the next byte it writes.
+ * @param  p_cmd      Decoded command (out), valid when 1 is returned.
+ * @return 1 if a line was consumed (its type may be NONE or INVALID),
+ *         0 if no complete line is available yet.
+ * @note   A line that fills the whole buffer without a terminator is
+ *         dropped as INVALID. Data overwritten by a producer that laps the
+ *         parser cannot be detected.
+ */
+uint8_t command_parser_next(CommandParser_t *p_parser,
+                            uint16_t write_pos,
+                            ActuatorCommand_t *p_cmd);
+
+/**
+ * @brief  Issue a decoded command to an actuator — main-loop context only.
+ *         From an ISR, use #actuator_post() instead.
+ * @param  p_act  Target actuator (already selected by `p_cmd->index`).
+ * @param  p_cmd  Command.
+ */
+void actuator_command_apply(ActuatorControl_t *p_act, const ActuatorCommand_t *p_cmd);
+
+#endif /* ACTUATOR_COMMAND_H */
@@ -15,8 +15,13 @@
 #define ACTUATOR_CONTROL_H
 
 #include <stdint.h>
+#include "actuator_queue.h"
 #include "button_debounce.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*   Macros                                                                   */
 /* -------------------------------------------------------------------------- */
@@ -28,8 +33,68 @@
  */
 #define MS_TO_TICKS(ms)     ((uint32_t)(ms))
 
+/** Microseconds per tick, for ActuatorConfig_t::timestamp_us. */
+#define ACTUATOR_US_PER_TICK    1000U
+
 #define DEBOUNCE_TIME_MS    3U
 
+/**
+ * @brief  Default break-before-make gap between the two relays.
+ *         The board's 5 V relays release in at most 5 ms (datasheet); the
+ *         rest covers the opening bounce and the arc on a DC motor load.
+ */
+#define RELAY_DEAD_TIME_MS  10U
+
+/**
+ * @brief  Default homing safety timeout.
+ *         If a limit switch is not pressed within this many ms after
+ *         starting a homing move, the actuator enters the error state.
+ *         Once travel times are known it is only the upper bound; see
+ *         #HOMING_TIMEOUT_MARGIN_PERCENT.
+ */
+#define HOMING_TIMEOUT_MS   10000U
+
+/**
+ * @brief  Default margin of the learned homing timeout: a phase times out
+ *         after the travel time measured by the last homing (or restored
+ *         from flash) plus this many percent.
+ */
+#define HOMING_TIMEOUT_MARGIN_PERCENT   25U
+
+/**
+ * @brief  Default stop lag: how long the actuator keeps moving after its
+ *         relay is released (relay release plus motor run-down). Timed
+ *         moves are cut this much early; see ActuatorConfig_t::stop_lag_ms.
+ */
+#define ACTUATOR_STOP_LAG_MS    5U
+
+/**
+ * @brief  Maximum number of distinct GPIO ports used by the four outputs.
+ */
+#define ACTUATOR_MAX_OUTPUT_PORTS   4U
+
+/**
+ * @brief  Actuator position scale: 0 = fully shrunk, 1000 = fully extended.
+ */
+#define ACTUATOR_POSITION_MAX       1000U
+#define ACTUATOR_POSITION_UNKNOWN   0xFFFFU
+
+/**
+ * @brief  Returned by #actuator_get_position_counts() without an encoder
+ *         calibration.
+ */
+#define ACTUATOR_COUNTS_UNKNOWN     INT32_MIN
+
+/**
+ * @brief  Default position the homing sequence parks at, in permille.
+ */
+#define ACTUATOR_PARK_POSITION      (ACTUATOR_POSITION_MAX / 2U)
+
+/**
+ * @brief  Returned by #actuator_next_deadline() when nothing is pending.
+ */
+#define ACTUATOR_NO_DEADLINE        0xFFFFFFFFU
+
 /* -------------------------------------------------------------------------- */
 /*   Enumerations                                                             */
 /* -------------------------------------------------------------------------- */
@@ -51,9 +116,29 @@ typedef enum {
     HOMING_PHASE_INIT   = 0, /**< Initial phase — moving to shrink (home) position */
     HOMING_PHASE_EXTEND = 1, /**< Extending while measuring full travel time       */
     HOMING_PHASE_SHRINK = 2, /**< Shrinking while measuring full travel time       */
-    HOMING_PHASE_MIDDLE = 3  /**< Moving to the calculated middle position         */
+    HOMING_PHASE_MIDDLE = 3  /**< Moving to the park position (park_position)      */
 } HomingPhase_t;
 
+/**
+ * @brief  Output patterns (relays + LEDs) driven by the state machine.
+ */
+typedef enum {
+    ACTUATOR_OUTPUT_STOP   = 0, /**< Both relays released, LEDs off          */
+    ACTUATOR_OUTPUT_EXTEND = 1, /**< Extend relay energised, extend LED on   */
+    ACTUATOR_OUTPUT_SHRINK = 2, /**< Shrink relay energised, shrink LED on   */
+    ACTUATOR_OUTPUT_COUNT  = 3
+} ActuatorOutput_t;
+
+/**
+ * @brief  Speed passed with each output pattern to an H-bridge backend
+ *         (ActuatorConfig_t::bridge_output); relays ignore it.
+ */
+typedef enum {
+    ACTUATOR_SPEED_FULL     = 0, /**< Ramp to full speed; a stop ramps down       */
+    ACTUATOR_SPEED_APPROACH = 1, /**< Ramp down to approach speed: end stop near  */
+    ACTUATOR_SPEED_CUT      = 2  /**< No ramp: drive off at once (switch, stall)  */
+} ActuatorSpeed_t;
+
 /* -------------------------------------------------------------------------- */
 /*   Structures                                                               */
 /* -------------------------------------------------------------------------- */
@@ -68,9 +153,43 @@ typedef struct {
     uint8_t       extend_active_level;     /**< GPIO level that drives the extend relay   */
     uint8_t       shrink_active_level;     /**< GPIO level that drives the shrink relay   */
     uint32_t      debounce_time_ms;        /**< Switch debounce window in ticks           */
-    void*         extend_control_port;     /**< GPIO port for extend control output       */
+    uint32_t      homing_timeout_ms;       /**< Homing safety timeout per phase in ticks  */
+    uint16_t      homing_margin_pct;       /**< Margin over the learned travel time for
+                                                the phase timeout, in percent; 0 = always
+                                                use homing_timeout_ms                      */
+    uint32_t      relay_dead_time_ms;      /**< Break-before-make gap in ticks between
+                                                releasing one relay and energising the
+                                                other; 0 = reverse at once                 */
+    uint32_t      stop_lag_ms;             /**< Travel after a relay release in ticks;
+                                                timed moves stop this much early           */
+    uint32_t      start_lag_ms;            /**< Travel time lost to acceleration after the
+                                                departing switch lets go, in ticks; added
+                                                to the measured start lags (H-bridge:
+                                                accel ramp / 2), 0 with relays             */
+    uint16_t      park_position;           /**< Where homing parks, in permille           */
+    uint8_t       stall_end_stop;          /**< Non-zero: a stall (#actuator_stall_isr())
+                                                ends travel like the limit switch ahead —
+                                                sensorless end stops; zero: it is a jam    */
+    uint16_t      approach_permille;       /**< Distance before an end stop from which the
+                                                H-bridge runs at approach speed, permille;
+                                                0 = full speed up to the switch            */
+    uint8_t       switch_edge_wakeup;      /**< Non-zero if every switch edge triggers an
+                                                update (EXTI) — no per-tick polling needed */
+    uint32_t    (*timestamp_us)(void);     /**< Free-running µs clock for travel timing
+                                                (with #actuator_switch_edge()), or NULL to
+                                                time travel in ticks                       */
+    int32_t     (*encoder_count)(void);    /**< Quadrature count, rising while extending,
+                                                for closed-loop positioning; NULL to
+                                                dead-reckon from travel times              */
+    void        (*bridge_output)(ActuatorOutput_t output, ActuatorSpeed_t speed);
+                                           /**< H-bridge backend given every pattern with
+                                                its speed, ramps in hardware; NULL for
+                                                relays only                                */
+    void*         extend_control_port;     /**< GPIO port for extend control output, NULL
+                                                if the H-bridge drives the motor alone     */
     uint16_t      extend_control_pin;      /**< GPIO pin  for extend control output       */
-    void*         shrink_control_port;     /**< GPIO port for shrink control output       */
+    void*         shrink_control_port;     /**< GPIO port for shrink control output, NULL
+                                                if the H-bridge drives the motor alone     */
     uint16_t      shrink_control_pin;      /**< GPIO pin  for shrink control output       */
     void*         extend_switch_port;      /**< GPIO port for extend limit switch input   */
     uint16_t      extend_switch_pin;       /**< GPIO pin  for extend limit switch input   */
@@ -82,6 +201,17 @@ typedef struct {
     uint16_t      led_shrink_pin;          /**< GPIO pin  for shrink-direction LED        */
 } ActuatorConfig_t;
 
+/**
+ * @brief  Precomputed output masks for one GPIO port.
+ * @note   Built by #actuator_init(). Each entry of `bsrr` is the complete
+ *         set/reset word for that output pattern, so switching pattern is a
+ *         single BSRR store per port.
+ */
+typedef struct {
+    void*         port;                             /**< GPIO port (as `void*`)          */
+    uint32_t      bsrr[ACTUATOR_OUTPUT_COUNT];      /**< BSRR word per ActuatorOutput_t  */
+} ActuatorOutputPort_t;
+
 /**
  * @brief  Actuator runtime control structure.
  * @note   All state is held here — no global variables in the module.
@@ -92,10 +222,54 @@ typedef struct {
     uint8_t           is_homing;              /**< Non-zero while homing sequence is active        */
     HomingPhase_t     homing_phase;           /**< Current phase of the homing sequence            */
     uint32_t          homing_last_phase_end_time; /**< Tick timestamp when last homing phase ended  */
+    uint32_t          homing_phase_timeout;   /**< Timeout of the current homing phase in ticks    */
+    uint32_t          park_time;              /**< Drive time of #HOMING_PHASE_MIDDLE: µs if
+                                                   extend_time_us is set, ticks otherwise       */
     uint32_t          extend_time;            /**< Full-extend travel time measured during homing  */
     uint32_t          shrink_time;            /**< Full-shrink travel time measured during homing  */
+    uint32_t          extend_lag;             /**< Ticks from energising extend to the debounced
+                                                   release of the shrink switch, 0 if not seen  */
+    uint32_t          shrink_lag;             /**< Same for shrink and the extend switch           */
+    uint32_t          learned_extend_time;    /**< extend_time of the last completed homing or
+                                                   restored calibration, 0 if none; kept while
+                                                   a new homing re-measures                     */
+    uint32_t          learned_shrink_time;    /**< Same for shrink_time                            */
+    uint16_t          position;               /**< Last known position in permille, or UNKNOWN     */
+    uint16_t          target_position;        /**< #actuator_move_to() target, or UNKNOWN if none  */
+    ActuatorState_t   motion_state;           /**< Direction of the tracked travel segment         */
+    uint16_t          motion_start_position;  /**< Position at the start of that segment           */
+    uint32_t          motion_start_time;      /**< Tick at which that segment started              */
+    uint32_t          target_due_time;        /**< Tick at which the target is reached             */
+    int32_t           target_count;           /**< Encoder count that ends the move or park        */
+    int32_t           encoder_zero;           /**< Encoder count at the shrink end stop            */
+    int32_t           encoder_end;            /**< Encoder count at the extend end stop (homing)   */
+    int32_t           encoder_span;           /**< Counts over the full stroke, 0 until homed      */
+    uint8_t           motion_replan;          /**< Non-zero if the next update must re-plan         */
     ButtonDebounce_t  extend_switch;          /**< Debounced extend limit switch                   */
     ButtonDebounce_t  shrink_switch;          /**< Debounced shrink limit switch                   */
+    ActuatorOutputPort_t output_ports[ACTUATOR_MAX_OUTPUT_PORTS]; /**< Per-port BSRR masks     */
+    uint8_t           output_port_count;      /**< Number of used entries in output_ports          */
+    ActuatorOutput_t  output;                 /**< Output pattern selected by the state machine    */
+    ActuatorSpeed_t   speed;                  /**< Speed last passed to bridge_output, FULL or
+                                                   APPROACH                                      */
+    uint8_t           output_deferred;        /**< Non-zero: patterns are collected, not written   */
+    uint8_t           output_dirty;           /**< Deferred pattern changed since last take        */
+    volatile uint8_t  limit_latch;            /**< Relays cut from EXTI, awaiting debounce verdict  */
+    volatile uint8_t  stall_latch;            /**< Relays cut on a motor stall, awaiting update    */
+    uint32_t          limit_latch_time;       /**< Tick at which the latch was first seen          */
+    ActuatorQueue_t   commands;               /**< Posted commands, drained by actuator_update()   */
+    uint8_t           id;                     /**< Index in its group; tags trace records          */
+    uint32_t          drive_start_us;         /**< timestamp_us() at the last change of state       */
+    volatile uint32_t extend_edge_us;         /**< First extend-switch edge since then             */
+    volatile uint32_t shrink_edge_us;         /**< First shrink-switch edge since then             */
+    volatile uint8_t  extend_edge_valid;      /**< Non-zero once extend_edge_us is set             */
+    volatile uint8_t  shrink_edge_valid;      /**< Non-zero once shrink_edge_us is set             */
+    uint32_t          extend_time_us;         /**< extend_time in µs, 0 unless edge-timed          */
+    uint32_t          shrink_time_us;         /**< shrink_time in µs, 0 unless edge-timed          */
+    uint8_t           relay_guard;            /**< Dead time running after a relay release         */
+    ActuatorOutput_t  relay_released;         /**< Direction whose relay was released last         */
+    ActuatorOutput_t  relay_pending;          /**< Direction held back for the dead time, or STOP  */
+    uint32_t          relay_release_time;     /**< Tick at which the release was first seen        */
 } ActuatorControl_t;
 
 /* -------------------------------------------------------------------------- */
@@ -116,12 +290,159 @@ void actuator_init(ActuatorControl_t *p_act, const ActuatorConfig_t *p_cfg);
  */
 void actuator_update(ActuatorControl_t *p_act, uint32_t current_time);
 
+/**
+ * @brief  Same as #actuator_update(), with the raw switch levels supplied by
+ *         the caller instead of read from the pins.
+ * @param  p_act        Pointer to the actuator control structure.
+ * @param  extend_level Raw GPIO level of the extend limit switch.
+ * @param  shrink_level Raw GPIO level of the shrink limit switch.
+ * @param  current_time Current system tick value.
+ */
+void actuator_update_raw(ActuatorControl_t *p_act,
+                         uint8_t extend_level,
+                         uint8_t shrink_level,
+                         uint32_t current_time);
+
+/**
+ * @brief  Same as #actuator_update(), with switch states the caller has
+ *         already debounced (e.g. one #ButtonDebouncePort_t per port).
+ *         The raw levels are still needed: an EXTI stop resumes only after
+ *         the switch has read open for a whole debounce window.
+ * @param  p_act          Pointer to the actuator control structure.
+ * @param  extend_pressed Non-zero if the extend limit switch is pressed.
+ * @param  shrink_pressed Non-zero if the shrink limit switch is pressed.
+ * @param  extend_level   Raw GPIO level of the extend limit switch.
+ * @param  shrink_level   Raw GPIO level of the shrink limit switch.
+ * @param  current_time   Current system tick value.
+ */
+void actuator_update_debounced(ActuatorControl_t *p_act,
+                               uint8_t extend_pressed,
+                               uint8_t shrink_pressed,
+                               uint8_t extend_level,
+                               uint8_t shrink_level,
+                               uint32_t current_time);
+
+/**
+ * @brief  Collect output patterns instead of writing them to the ports.
+ *
+ *         Lets a caller that owns several actuators merge their writes into
+ *         one BSRR store per port. #actuator_limit_switch_isr() still
+ *         releases the relays directly, and ActuatorConfig_t::bridge_output
+ *         is not a port write and is always called at once.
+ *
+ * @param  p_act     Pointer to the actuator control structure.
+ * @param  deferred  Non-zero to defer, zero to write immediately (default).
+ */
+void actuator_defer_outputs(ActuatorControl_t *p_act, uint8_t deferred);
+
+/**
+ * @brief  Fetch the deferred output pattern if it changed.
+ * @param  p_act     Pointer to the actuator control structure.
+ * @param  p_output  Pattern to write (out); STOP while an EXTI stop is pending.
+ * @return Non-zero if the pattern changed since the last call.
+ */
+uint8_t actuator_take_output(ActuatorControl_t *p_act, ActuatorOutput_t *p_output);
+
+/**
+ * @brief  Non-zero while an EXTI or stall stop holds the outputs cut. The
+ *         ISR can fire after #actuator_take_output(); check again right
+ *         before writing a taken EXTEND / SHRINK pattern.
+ * @param  p_act     Pointer to the actuator control structure.
+ */
+uint8_t actuator_output_cut(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Ticks until #actuator_update() next has work to do.
+ *
+ *         Covers posted commands, debounce expiry, a pending EXTI stop, the homing phase
+ *         timeout, the end of the #HOMING_PHASE_MIDDLE move and the arrival
+ *         at an #actuator_move_to() target. While moving
+ *         without `switch_edge_wakeup` the switches must be polled, so the
+ *         result is 1.
+ *
+ * @param  p_act        Pointer to the actuator control structure (read-only).
+ * @param  current_time Current system tick value.
+ * @return 0 if an update is due now, #ACTUATOR_NO_DEADLINE if the actuator
+ *         only needs updating on an external event (command, switch edge).
+ */
+uint32_t actuator_next_deadline(const ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Limit-switch edge handler — call from the EXTI callback.
+ *
+ *         If the edge brings the switch in the current direction of travel
+ *         to its active level, both relays are released and the H-bridge
+ *         cut (#ACTUATOR_SPEED_CUT) immediately. The
+ *         next #actuator_update() calls then either confirm the stop through
+ *         the debouncer or, if the edge was a glitch, resume the move.
+ *
+ * @param  p_act     Pointer to the actuator control structure.
+ * @param  gpio_pin  GPIO pin mask that triggered the interrupt.
+ */
+void actuator_limit_switch_isr(ActuatorControl_t *p_act, uint16_t gpio_pin);
+
+/**
+ * @brief  Motor-stall handler — call when the current sense reports a stall
+ *         (actuator_current.h), from interrupt context or the main loop.
+ *
+ *         While travelling, both relays are released and the H-bridge cut
+ *         immediately. The next
+ *         #actuator_update() then ends the travel as if the limit switch
+ *         ahead had closed if ActuatorConfig_t::stall_end_stop is set and
+ *         the state machine is waiting for that switch; any other stall is
+ *         a jam and enters #ACTUATOR_ERROR, aborting a homing run.
+ *
+ * @param  p_act     Pointer to the actuator control structure.
+ */
+void actuator_stall_isr(ActuatorControl_t *p_act);
+
+/**
+ * @brief  Limit-switch edge timestamp — call from the input-capture ISR.
+ *
+ *         Keeps the first edge of each switch after the actuator last
+ *         changed state. When homing confirms that switch, the travel time
+ *         is taken from the drive start to this edge, to the microsecond and
+ *         without the debounce delay. Needs ActuatorConfig_t::timestamp_us.
+ *
+ * @param  p_act         Pointer to the actuator control structure.
+ * @param  gpio_pin      GPIO pin mask of the switch.
+ * @param  timestamp_us  Edge time on the ActuatorConfig_t::timestamp_us clock.
+ */
+void actuator_switch_edge(ActuatorControl_t *p_act, uint16_t gpio_pin, uint32_t timestamp_us);
+
+/**
+ * @brief  Queue a command for the next #actuator_update() — callable from
+ *         an ISR without masking interrupts.
+ *
+ *         The update drains the queue before it evaluates the state
+ *         machine, so the command takes effect in that same tick. Only one
+ *         context may post to a given actuator.
+ *
+ * @param  p_act  Pointer to the actuator control structure.
+ * @param  p_cmd  Command to queue (`index` is not used).
+ * @return Non-zero if queued, zero if the queue is full.
+ */
+uint8_t actuator_post(ActuatorControl_t *p_act, const ActuatorCommand_t *p_cmd);
+
 /**
  * @brief  Start the homing sequence (non-blocking).
  * @param  p_act  Pointer to the actuator control structure.
  */
 void actuator_start_homing(ActuatorControl_t *p_act);
 
+/**
+ * @brief  Resume from a previously measured calibration without homing.
+ * @param  p_act        Pointer to the actuator control structure.
+ * @param  extend_time  Full-extend travel time (ticks), non-zero.
+ * @param  shrink_time  Full-shrink travel time (ticks), non-zero.
+ * @param  position     Position in permille (0..ACTUATOR_POSITION_MAX).
+ * @note   Ignored while the actuator is moving or if any value is invalid.
+ */
+void actuator_restore_calibration(ActuatorControl_t *p_act,
+                                  uint32_t extend_time,
+                                  uint32_t shrink_time,
+                                  uint16_t position);
+
 /**
  * @brief  Get the current actuator state.
  * @param  p_act  Pointer to the actuator control structure (read-only).
@@ -136,6 +457,31 @@ ActuatorState_t actuator_get_state(const ActuatorControl_t *p_act);
  */
 uint8_t actuator_is_homing(const ActuatorControl_t *p_act);
 
+/**
+ * @brief  Check whether travel times have been measured (or restored).
+ * @param  p_act  Pointer to the actuator control structure (read-only).
+ * @return Non-zero if both travel times are known and homing is not running.
+ */
+uint8_t actuator_is_calibrated(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Get the position estimate.
+ * @param  p_act  Pointer to the actuator control structure (read-only).
+ * @return Position in permille of the stroke as of the last
+ *         #actuator_update() — from the encoder count once homing has
+ *         measured the stroke in counts — or #ACTUATOR_POSITION_UNKNOWN.
+ */
+uint16_t actuator_get_position(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Get the encoder position.
+ * @param  p_act  Pointer to the actuator control structure (read-only).
+ * @return Counts from the shrink end stop, read now, or
+ *         #ACTUATOR_COUNTS_UNKNOWN without an encoder or before homing
+ *         has measured the stroke in counts.
+ */
+int32_t actuator_get_position_counts(const ActuatorControl_t *p_act);
+
 /**
  * @brief  Check if the actuator is in the error state.
  * @param  p_act  Pointer to the actuator control structure (read-only).
@@ -161,4 +507,28 @@ void actuator_shrink(ActuatorControl_t *p_act);
  */
 void actuator_stop(ActuatorControl_t *p_act);
 
+/**
+ * @brief  Move to a position and stop there.
+ *
+ *         The position is dead-reckoned from the travel times measured
+ *         during homing, separately for each direction. With an encoder
+ *         (ActuatorConfig_t::encoder_count) homed, it is measured instead
+ *         and the relay is released at a target count, ahead of the target
+ *         by the stop lag at the homing speed. Targets 0 and
+ *         #ACTUATOR_POSITION_MAX run to the limit switch, which also resets
+ *         the estimate to the exact end position. The direction is chosen
+ *         from the estimate of the last #actuator_update(); travel timing
+ *         starts at the next one.
+ *
+ * @param  p_act     Pointer to the actuator control structure.
+ * @param  permille  Target position (0..ACTUATOR_POSITION_MAX).
+ * @note   Ignored while homing, in the error state, when the actuator is
+ *         not calibrated or its position is unknown.
+ */
+void actuator_move_to(ActuatorControl_t *p_act, uint16_t permille);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* ACTUATOR_CONTROL_H */
\ No newline at end of file
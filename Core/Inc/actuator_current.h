@@ -0,0 +1,107 @@
+/**
+ * @file    actuator_current.h
+ * @brief   Streaming motor-stall detector over a circular buffer of current
+ *          samples.
+ *
+ * A DMA channel (or any other producer) keeps writing ADC readings of the
+ * motor current into a ring; #actuator_current_process() consumes what was
+ * written since the last call, in place, without copying. Samples are
+ * averaged in blocks of `2^block_shift`, which filters brush and relay
+ * noise, and each block mean is compared with `threshold`:
+ *
+ *   - the first `blank_blocks` blocks after the motor starts are ignored —
+ *     the inrush current of a DC motor is a stall current for a few tens of
+ *     milliseconds;
+ *   - `stall_blocks` consecutive blocks at or above the threshold report a
+ *     stall, once, until the motor is stopped and started again.
+ *
+ * Report a stall to the actuator with actuator_stall_isr(), which cuts the
+ * relays at once and lets the next actuator_update() decide (end stop or
+ * jam, see ActuatorConfig_t::stall_end_stop).
+ *
+ * @note    HAL-agnostic; builds on the host as well as on the target, where
+ *          current_sense.h provides the ADC1 / DMA ring.
+ */
+
+#ifndef ACTUATOR_CURRENT_H
+#define ACTUATOR_CURRENT_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Detector settings. Times are in blocks of `2^block_shift` samples.
+ */
+typedef struct {
+    uint16_t threshold;             /**< Block mean, ADC counts, that counts as stalled */
+    uint16_t blank_blocks;          /**< Blocks ignored after the motor starts (inrush) */
+    uint16_t stall_blocks;          /**< Consecutive blocks at or above `threshold`     */
+    uint8_t  block_shift;           /**< log2 of the samples per block (0..8)           */
+} ActuatorCurrentConfig_t;
+
+/**
+ * @brief  Detector state over a ring of 16-bit samples.
+ * @note   Positions are offsets into the ring, 0..size-1.
+ */
+typedef struct {
+    ActuatorCurrentConfig_t   config;
+    const volatile uint16_t  *p_ring;   /**< Ring written by the producer (DMA)     */
+    uint16_t                  mask;     /**< size - 1; size is a power of two       */
+    uint16_t                  read_pos; /**< First sample not yet consumed          */
+    uint32_t                  sum;      /**< Samples of the current block so far    */
+    uint16_t                  count;    /**< Number of samples in `sum`             */
+    uint16_t                  level;    /**< Mean of the last complete block        */
+    uint16_t                  peak;     /**< Highest block mean since the start     */
+    uint16_t                  blank;    /**< Blanking blocks still to skip          */
+    uint16_t                  over;     /**< Consecutive blocks at or above threshold */
+    uint8_t                   running;  /**< Drive in use, 0 while stopped          */
+    uint8_t                   stalled;  /**< Non-zero once a stall was reported     */
+} ActuatorCurrent_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Attach a detector to a ring of samples.
+ * @param  p_cur    Detector (out).
+ * @param  p_ring   Ring filled by the producer; NULL if only
+ *                  #actuator_current_feed() is used.
+ * @param  size     Ring size in samples — a power of two (>= 2).
+ * @param  p_cfg    Settings.
+ * @return Non-zero on success, zero on a bad size or `block_shift`.
+ */
+uint8_t actuator_current_init(ActuatorCurrent_t *p_cur,
+                              const volatile uint16_t *p_ring,
+                              uint16_t size,
+                              const ActuatorCurrentConfig_t *p_cfg);
+
+/**
+ * @brief  Tell the detector how the motor is driven.
+ * @param  p_cur    Detector.
+ * @param  running  0 while stopped; any other value names the drive (e.g.
+ *                  the #ActuatorOutput_t). A start or a change of drive
+ *                  restarts the blanking window and re-arms the stall report.
+ */
+void actuator_current_set_running(ActuatorCurrent_t *p_cur, uint8_t running);
+
+/**
+ * @brief  Consume every sample written since the last call.
+ * @param  p_cur      Detector.
+ * @param  write_pos  Producer position: offset of the next sample it writes.
+ * @return 1 if a stall was detected in these samples, 0 otherwise.
+ * @note   Samples overwritten by a producer that laps the detector cannot
+ *         be detected; call at least once per ring length.
+ */
+uint8_t actuator_current_process(ActuatorCurrent_t *p_cur, uint16_t write_pos);
+
+/**
+ * @brief  Feed one sample directly (recorded traces, tests).
+ * @return 1 if this sample completed a stall, 0 otherwise.
+ */
+uint8_t actuator_current_feed(ActuatorCurrent_t *p_cur, uint16_t sample);
+
+#endif /* ACTUATOR_CURRENT_H */
@@ -0,0 +1,47 @@
+/**
+ * @file    actuator_encoder.h
+ * @brief   Quadrature encoder counted by TIM2 in encoder mode, extended to
+ *          32 bits.
+ *
+ * PA0 and PA1 (TIM2_CH1 / TIM2_CH2) take the A and B channels of the
+ * actuator's encoder. TIM2 counts every edge of both (encoder mode 3, four
+ * counts per line) up or down in hardware, with an input filter against
+ * motor noise; the CPU only sees the update interrupt once every 65536
+ * counts, which extends the counter to 32 bits.
+ *
+ * Pass #actuator_encoder_count() as ActuatorConfig_t::encoder_count to
+ * position on the count instead of on travel times.
+ *
+ * @note    Target only. Register-level set-up. TIM3/TIM4 are the microsecond
+ *          timebase (actuator_timebase.h), so the encoder takes TIM2. The
+ *          counter stops in STOP mode.
+ */
+
+#ifndef ACTUATOR_ENCODER_H
+#define ACTUATOR_ENCODER_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Configure PA0/PA1 and TIM2 and start counting from zero.
+ * @param  inverted  Non-zero if the count falls while extending; swaps the
+ *                   direction so that it rises.
+ */
+void actuator_encoder_init(uint8_t inverted);
+
+/**
+ * @brief  Current count; wraps after 2^32 counts.
+ * @note   Call from code below the TIM2 interrupt priority, or with it masked.
+ */
+int32_t actuator_encoder_count(void);
+
+/**
+ * @brief  TIM2 interrupt body — call from TIM2_IRQHandler().
+ */
+void actuator_encoder_irq_handler(void);
+
+#endif /* ACTUATOR_ENCODER_H */
@@ -0,0 +1,102 @@
+/**
+ * @file    actuator_gpio.h
+ * @brief   Thin GPIO driver used by the actuator modules.
+ *
+ * Ports arrive as `void*` from the HAL-agnostic #ActuatorConfig_t; these
+ * inline helpers are the only place where they meet the GPIO registers.
+ *
+ * With `ACTUATOR_GPIO_LL` set (the default) they are built on
+ * `stm32f1xx_ll_gpio.h`: a read is one IDR load, a write one BSRR store,
+ * inlined into the caller, without the call, `assert_param()` and
+ * `GPIO_PinState` round trip of HAL_GPIO_ReadPin() / HAL_GPIO_WritePin(), and
+ * without pulling the HAL into the actuator modules.
+ *
+ * Build with `-DACTUATOR_GPIO_LL=0` to go through the HAL calls instead, e.g.
+ * to compare the two. The HAL has no whole-port read and no BSRR write: the
+ * port read stays a register load, and a write becomes one
+ * HAL_GPIO_WritePin() per half, so set and reset pins change one call apart.
+ */
+
+#ifndef ACTUATOR_GPIO_H
+#define ACTUATOR_GPIO_H
+
+#include <stdint.h>
+
+#ifndef ACTUATOR_GPIO_LL
+#define ACTUATOR_GPIO_LL            1U
+#endif
+
+#if ACTUATOR_GPIO_LL
+#include "stm32f1xx_ll_gpio.h"
+#else
+#include "stm32f1xx_hal.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*   Masks                                                                    */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  BSRR word that drives `pins` to `level`: the low half sets,
+ *         the high half resets.
+ */
+static inline uint32_t actuator_gpio_bsrr(uint16_t pins, uint8_t level)
+{
+    return (level != 0U) ? (uint32_t)pins : ((uint32_t)pins << 16U);
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Read / write                                                             */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Input levels of all 16 pins of a port.
+ */
+static inline uint16_t actuator_gpio_read(void *port)
+{
+#if ACTUATOR_GPIO_LL
+    return (uint16_t)LL_GPIO_ReadInputPort((GPIO_TypeDef*)port);
+#else
+    return (uint16_t)((GPIO_TypeDef*)port)->IDR;
+#endif
+}
+
+/**
+ * @brief  Input level of one pin.
+ * @return 1 if any pin of `pin` is high, 0 otherwise.
+ */
+static inline uint8_t actuator_gpio_read_pin(void *port, uint16_t pin)
+{
+#if ACTUATOR_GPIO_LL
+    return ((LL_GPIO_ReadInputPort((GPIO_TypeDef*)port) & pin) != 0U) ? 1U : 0U;
+#else
+    return (uint8_t)HAL_GPIO_ReadPin((GPIO_TypeDef*)port, pin);
+#endif
+}
+
+/**
+ * @brief  Apply a BSRR word (see #actuator_gpio_bsrr()) to a port.
+ */
+static inline void actuator_gpio_write(void *port, uint32_t bsrr)
+{
+#if ACTUATOR_GPIO_LL
+    LL_GPIO_WriteReg(((GPIO_TypeDef*)port), BSRR, bsrr);
+#else
+    if ((bsrr & 0xFFFFU) != 0U) {
+        HAL_GPIO_WritePin((GPIO_TypeDef*)port, (uint16_t)bsrr, GPIO_PIN_SET);
+    }
+    if ((bsrr >> 16U) != 0U) {
+        HAL_GPIO_WritePin((GPIO_TypeDef*)port, (uint16_t)(bsrr >> 16U), GPIO_PIN_RESET);
+    }
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ACTUATOR_GPIO_H */
@@ -0,0 +1,145 @@
+/**
+ * @file    actuator_group.h
+ * @brief   Several actuators driven from one update pass.
+ *
+ * Holds a fixed-size array of #ActuatorControl_t and the GPIO ports their
+ * pins live on. Each #actuator_group_update() reads every input port's IDR
+ * once, debounces all switches of that port with one #ButtonDebouncePort_t,
+ * feeds the debounced states to the actuators, and merges the output
+ * changes of all actuators into one BSRR store per port. GPIO traffic and
+ * debounce work per update therefore depend on the number of ports, not of
+ * actuators.
+ *
+ * The port debouncer is sample based: one sample per tick, and a switch
+ * changes state after `debounce_time_ms + 1` agreeing samples (the same
+ * delay as #ButtonDebounce_t), capped at #BUTTON_DEBOUNCE_PORT_MAX_SAMPLES.
+ * #actuator_group_next_deadline() keeps the loop ticking while a count runs.
+ *
+ * @note    Like actuator_control.h this header is HAL-agnostic; ports are
+ *          `void*` and cast in the implementation.
+ */
+
+#ifndef ACTUATOR_GROUP_H
+#define ACTUATOR_GROUP_H
+
+#include <stdint.h>
+#include "actuator_control.h"
+#include "button_debounce.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Macros                                                                   */
+/* -------------------------------------------------------------------------- */
+
+/** Maximum number of actuators in one group. */
+#define ACTUATOR_GROUP_MAX_ACTUATORS    4U
+
+/** Maximum number of distinct GPIO ports used by the whole group. */
+#define ACTUATOR_GROUP_MAX_PORTS        4U
+
+/** Marks an unused port slot. */
+#define ACTUATOR_GROUP_NO_PORT          0xFFU
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  One GPIO port touched by the group.
+ */
+typedef struct {
+    void*                port;          /**< GPIO port (as `void*`)                */
+    uint8_t              is_input;      /**< Non-zero if a limit switch is on it   */
+    uint16_t             idr;           /**< IDR sampled by the last update        */
+    uint32_t             bsrr;          /**< Output changes collected this update  */
+    ButtonDebouncePort_t debounce;      /**< Switches of all actuators on the port */
+} ActuatorGroupPort_t;
+
+/**
+ * @brief  Group runtime structure.
+ * @note   All state is held here — no global variables in the module.
+ */
+typedef struct {
+    ActuatorControl_t   actuators[ACTUATOR_GROUP_MAX_ACTUATORS];
+    uint8_t             actuator_count;
+    ActuatorGroupPort_t ports[ACTUATOR_GROUP_MAX_PORTS];
+    uint8_t             port_count;
+    uint8_t             extend_switch_port[ACTUATOR_GROUP_MAX_ACTUATORS]; /**< Index into ports */
+    uint8_t             shrink_switch_port[ACTUATOR_GROUP_MAX_ACTUATORS]; /**< Index into ports */
+    uint8_t             output_port[ACTUATOR_GROUP_MAX_ACTUATORS][ACTUATOR_MAX_OUTPUT_PORTS];
+                                        /**< Group port of each actuator output_ports entry  */
+    uint32_t            sample_time;    /**< Tick of the last debounce sample */
+    uint8_t             sampled;        /**< Non-zero once a sample was taken */
+} ActuatorGroup_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Initialise every actuator of the group.
+ * @param  p_group  Pointer to the group structure (out).
+ * @param  p_cfgs   Array of `count` hardware configurations.
+ * @param  count    Number of actuators, 1..#ACTUATOR_GROUP_MAX_ACTUATORS.
+ * @return Number of actuators initialised; 0 if the arguments are invalid or
+ *         the pins span more than #ACTUATOR_GROUP_MAX_PORTS ports.
+ */
+uint8_t actuator_group_init(ActuatorGroup_t *p_group,
+                            const ActuatorConfig_t *p_cfgs,
+                            uint8_t count);
+
+/**
+ * @brief  Access one actuator to issue commands or query it.
+ * @return Pointer to the actuator, or NULL if `index` is out of range.
+ */
+ActuatorControl_t *actuator_group_get(ActuatorGroup_t *p_group, uint8_t index);
+
+/**
+ * @brief  Queue a command for the actuator selected by `p_cmd->index`.
+ *         ISR-safe; see #actuator_post().
+ * @return Non-zero if queued, zero if the index is out of range or that
+ *         actuator's queue is full.
+ */
+uint8_t actuator_group_post(ActuatorGroup_t *p_group, const ActuatorCommand_t *p_cmd);
+
+/**
+ * @brief  Periodic update — samples all input ports, updates every actuator
+ *         and writes the collected output changes, one BSRR store per port.
+ *         A second call within the same tick updates the actuators without
+ *         feeding the debouncers another sample.
+ * @param  p_group      Pointer to the group structure.
+ * @param  current_time Current system tick value from HAL_GetTick().
+ */
+void actuator_group_update(ActuatorGroup_t *p_group, uint32_t current_time);
+
+/**
+ * @brief  Ticks until #actuator_group_update() next has work to do — the
+ *         minimum of #actuator_next_deadline() over all actuators, or one
+ *         tick while a port debouncer is counting.
+ */
+uint32_t actuator_group_next_deadline(const ActuatorGroup_t *p_group, uint32_t current_time);
+
+/**
+ * @brief  Non-zero if no actuator of the group is driving its motor or
+ *         homing — e.g. to schedule flash writes.
+ */
+uint8_t actuator_group_is_idle(const ActuatorGroup_t *p_group);
+
+/**
+ * @brief  Limit-switch edge handler — call from the EXTI callback. Forwards
+ *         the edge to every actuator with a switch on that pin number.
+ */
+void actuator_group_limit_switch_isr(ActuatorGroup_t *p_group, uint16_t gpio_pin);
+
+/**
+ * @brief  Captured limit-switch edge — call from the input-capture ISR.
+ *         Forwards the timestamp (#actuator_switch_edge()) only to the
+ *         actuator whose switch is on that port and pin.
+ * @param  p_group       Pointer to the group structure.
+ * @param  port          GPIO port of the captured pin (as `void*`).
+ * @param  gpio_pin      Captured pin.
+ * @param  timestamp_us  Time of the edge.
+ */
+void actuator_group_switch_edge(ActuatorGroup_t *p_group, void *port,
+                                uint16_t gpio_pin, uint32_t timestamp_us);
+
+#endif /* ACTUATOR_GROUP_H */
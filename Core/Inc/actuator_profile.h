@@ -0,0 +1,124 @@
+/**
+ * @file    actuator_profile.h
+ * @brief   Opt-in cycle-count instrumentation for the actuator control loop.
+ *
+ * Measures sections of code with the Cortex-M3 DWT cycle counter
+ * (`DWT->CYCCNT`, 72 cycles per microsecond at 72 MHz) and keeps min / max /
+ * average per slot in #actuator_profile, a plain RAM struct a debugger can
+ * watch. #actuator_profile_dump() prints the table on demand.
+ *
+ * Build with `-DACTUATOR_PROFILE_ENABLED=1` to enable. Otherwise every
+ * ACTUATOR_PROFILE_* macro expands to nothing, nothing is linked and the
+ * cost is zero.
+ *
+ * @note    Recorded from the main loop only; the EXTI relay cut-off is not
+ *          measured, so no stats are torn by interrupts. Every slot times
+ *          code that runs without sleeping, far below the 59 s wrap of the
+ *          32-bit CYCCNT at 72 MHz; time spent in WFI or STOP is never
+ *          counted.
+ */
+
+#ifndef ACTUATOR_PROFILE_H
+#define ACTUATOR_PROFILE_H
+
+#include <stdint.h>
+
+#ifndef ACTUATOR_PROFILE_ENABLED
+#define ACTUATOR_PROFILE_ENABLED    0U
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*   Enumerations                                                             */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Measured sections. The first four follow ActuatorState_t so the
+ *         update slot is `ACTUATOR_PROFILE_UPDATE_IDLE + state`.
+ */
+typedef enum {
+    ACTUATOR_PROFILE_UPDATE_IDLE = 0,   /**< actuator_update() in ACTUATOR_IDLE       */
+    ACTUATOR_PROFILE_UPDATE_EXTENDING,  /**< actuator_update() in ACTUATOR_EXTENDING  */
+    ACTUATOR_PROFILE_UPDATE_SHRINKING,  /**< actuator_update() in ACTUATOR_SHRINKING  */
+    ACTUATOR_PROFILE_UPDATE_ERROR,      /**< actuator_update() in ACTUATOR_ERROR      */
+    ACTUATOR_PROFILE_UPDATE_HOMING,     /**< actuator_update() while homing           */
+    ACTUATOR_PROFILE_SWITCHES,          /**< update_switches()                        */
+    ACTUATOR_PROFILE_OUTPUTS,           /**< Output write (set_outputs())             */
+    ACTUATOR_PROFILE_LOOP_PASS,         /**< Main loop: one update pass, no sleep     */
+    ACTUATOR_PROFILE_SLOT_COUNT
+} ActuatorProfileSlot_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t count;                     /**< Samples recorded                     */
+    uint32_t min;                       /**< Fewest cycles (0xFFFFFFFF if none)   */
+    uint32_t max;                       /**< Most cycles                          */
+    uint64_t total;                     /**< Sum, for the average                 */
+} ActuatorProfileStats_t;
+
+typedef struct {
+    ActuatorProfileStats_t slots[ACTUATOR_PROFILE_SLOT_COUNT];
+    uint32_t               overhead;    /**< Cycles of an empty START/STOP pair, subtracted */
+} ActuatorProfile_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Macros                                                                   */
+/* -------------------------------------------------------------------------- */
+
+#if ACTUATOR_PROFILE_ENABLED
+
+#include "stm32f1xx.h"              /* DWT, CoreDebug */
+
+/** Statistics, readable by a debugger. */
+extern ActuatorProfile_t actuator_profile;
+
+/**
+ * @brief  Start timing a section to be recorded under `slot`. Declares the
+ *         locals `name` (start cycle count) and `name##_slot`.
+ */
+#define ACTUATOR_PROFILE_START(name, slot)                                  \
+    const ActuatorProfileSlot_t name##_slot = (slot);                       \
+    const uint32_t              name        = DWT->CYCCNT
+
+/** Stop timing the section started as `name` and record it. */
+#define ACTUATOR_PROFILE_STOP(name)                                         \
+    actuator_profile_record(name##_slot, DWT->CYCCNT - (name))
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Enable the DWT cycle counter, clear all stats and measure the
+ *         START/STOP overhead.
+ */
+void actuator_profile_init(void);
+
+/**
+ * @brief  Clear all stats (the counter keeps running).
+ */
+void actuator_profile_reset(void);
+
+/**
+ * @brief  Add one sample to a slot.
+ * @param  slot    Slot to update.
+ * @param  cycles  Measured cycles, including the START/STOP overhead.
+ */
+void actuator_profile_record(ActuatorProfileSlot_t slot, uint32_t cycles);
+
+/**
+ * @brief  Print one line per slot: name, count, min, avg, max (cycles).
+ * @param  p_write  Output sink, e.g. a UART or ITM write; called per line.
+ */
+void actuator_profile_dump(void (*p_write)(const char *p_text, uint16_t length));
+
+#else
+
+#define ACTUATOR_PROFILE_START(name, slot)  ((void)0)
+#define ACTUATOR_PROFILE_STOP(name)         ((void)0)
+
+#endif /* ACTUATOR_PROFILE_ENABLED */
+
+#endif /* ACTUATOR_PROFILE_H */
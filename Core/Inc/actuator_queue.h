@@ -0,0 +1,104 @@
+/**
+ * @file    actuator_queue.h
+ * @brief   Command records and a lock-free single-producer / single-consumer
+ *          queue that carries them from interrupt context to
+ *          actuator_update().
+ *
+ * Each actuator owns one queue. Exactly one context may push (e.g. the
+ * USART1 idle-line ISR) and only actuator_update() pops, so neither side
+ * masks interrupts: the producer only writes `head`, the consumer only
+ * writes `tail`, and both are single-byte stores.
+ *
+ * @note    HAL-agnostic; builds on the host as well as on the target.
+ */
+
+#ifndef ACTUATOR_QUEUE_H
+#define ACTUATOR_QUEUE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*   Macros                                                                   */
+/* -------------------------------------------------------------------------- */
+
+/** Queue capacity — a power of two, at most 128. */
+#define ACTUATOR_QUEUE_SIZE     8U
+
+/* -------------------------------------------------------------------------- */
+/*   Enumerations                                                             */
+/* -------------------------------------------------------------------------- */
+
+typedef enum {
+    ACTUATOR_CMD_NONE = 0,              /**< Empty line                           */
+    ACTUATOR_CMD_EXTEND,                /**< actuator_extend()                    */
+    ACTUATOR_CMD_SHRINK,                /**< actuator_shrink()                    */
+    ACTUATOR_CMD_STOP,                  /**< actuator_stop()                      */
+    ACTUATOR_CMD_HOME,                  /**< actuator_start_homing()              */
+    ACTUATOR_CMD_MOVE_TO,               /**< actuator_move_to(argument)           */
+    ACTUATOR_CMD_INVALID                /**< Unknown keyword or bad argument      */
+} ActuatorCommandType_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  One command.
+ */
+typedef struct {
+    ActuatorCommandType_t type;
+    uint8_t               index;        /**< Target actuator                      */
+    uint16_t              argument;     /**< MOVE target in permille              */
+} ActuatorCommand_t;
+
+/**
+ * @brief  Fixed-capacity SPSC ring of commands.
+ * @note   `head` and `tail` run freely modulo 256; the slot is the low bits.
+ */
+typedef struct {
+    ActuatorCommand_t slots[ACTUATOR_QUEUE_SIZE];
+    volatile uint8_t  head;             /**< Next slot to fill — producer only    */
+    volatile uint8_t  tail;             /**< Next slot to read — consumer only    */
+} ActuatorQueue_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Empty the queue. Not safe while either side is active.
+ * @param  p_queue  Queue (out).
+ */
+void actuator_queue_init(ActuatorQueue_t *p_queue);
+
+/**
+ * @brief  Append a command — producer side, callable from an ISR.
+ * @param  p_queue  Queue.
+ * @param  p_cmd    Command to copy in.
+ * @return Non-zero on success, zero if the queue is full (command dropped).
+ */
+uint8_t actuator_queue_push(ActuatorQueue_t *p_queue, const ActuatorCommand_t *p_cmd);
+
+/**
+ * @brief  Remove the oldest command — consumer side.
+ * @param  p_queue  Queue.
+ * @param  p_cmd    Command (out), valid when 1 is returned.
+ * @return Non-zero if a command was removed, zero if the queue is empty.
+ */
+uint8_t actuator_queue_pop(ActuatorQueue_t *p_queue, ActuatorCommand_t *p_cmd);
+
+/**
+ * @brief  Check for queued commands. Safe from either side.
+ * @return Non-zero if at least one command is waiting.
+ */
+uint8_t actuator_queue_pending(const ActuatorQueue_t *p_queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ACTUATOR_QUEUE_H */
@@ -0,0 +1,37 @@
+/**
+ * @file    actuator_ramfunc.h
+ * @brief   Placement of the control hot path in SRAM.
+ *
+ * At 72 MHz the flash needs two wait states (`FLASH_LATENCY_2`); the
+ * prefetch buffer hides them on straight-line code but not after a taken
+ * branch, and the state machine is mostly branches. Functions marked
+ * #ACTUATOR_RAMFUNC go to the `.RamFunc` input section, which
+ * `STM32F103C8TX_FLASH.ld` places inside `.data`: the startup code copies
+ * them from flash to SRAM together with the initialised data, and they are
+ * fetched from SRAM with no wait states from then on. Calls between RAM
+ * and flash code go through linker-generated long-branch veneers.
+ *
+ * Build with `-DACTUATOR_RAMFUNC_ENABLED=0` to keep everything in flash,
+ * e.g. to compare the two with the profile build (#ACTUATOR_PROFILE_ENABLED).
+ * Host builds keep it off; the placement only matters on the target.
+ */
+
+#ifndef ACTUATOR_RAMFUNC_H
+#define ACTUATOR_RAMFUNC_H
+
+#ifndef ACTUATOR_RAMFUNC_ENABLED
+#if defined(__arm__)
+#define ACTUATOR_RAMFUNC_ENABLED    1U
+#else
+#define ACTUATOR_RAMFUNC_ENABLED    0U
+#endif
+#endif
+
+#if ACTUATOR_RAMFUNC_ENABLED
+/** Execute this function from SRAM. */
+#define ACTUATOR_RAMFUNC            __attribute__((section(".RamFunc")))
+#else
+#define ACTUATOR_RAMFUNC
+#endif
+
+#endif /* ACTUATOR_RAMFUNC_H */
@@ -0,0 +1,88 @@
+/**
+ * @file    actuator_ramp.h
+ * @brief   Duty-cycle ramp generator for an H-bridge motor drive.
+ *
+ * Turns the direction and speed requests of the state machine
+ * (ActuatorConfig_t::bridge_output) into a PWM duty that changes by a
+ * bounded step per call of #actuator_ramp_step():
+ *
+ *   - a start ramps from 0 up to `full_duty` in `accel_ms`;
+ *   - a stop, or a drop to `approach_duty` near an end stop, ramps down at
+ *     `full_duty` per `decel_ms`;
+ *   - a reversal ramps down to 0 first and only then changes direction;
+ *   - #ACTUATOR_SPEED_CUT drops the duty to 0 at once (limit switch, stall).
+ *
+ * The step is meant to run from a timer interrupt at `step_hz`; the duty it
+ * leaves in #ActuatorRamp_t is written to the timer's preloaded compare
+ * registers (actuator_bridge.h), so the main loop never writes a duty.
+ *
+ * @note    HAL-agnostic; builds on the host as well as on the target.
+ */
+
+#ifndef ACTUATOR_RAMP_H
+#define ACTUATOR_RAMP_H
+
+#include <stdint.h>
+#include "actuator_control.h"       /* ActuatorOutput_t, ActuatorSpeed_t */
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Ramp settings. Duties are in timer counts.
+ */
+typedef struct {
+    uint16_t full_duty;             /**< Duty at #ACTUATOR_SPEED_FULL                  */
+    uint16_t approach_duty;         /**< Duty at #ACTUATOR_SPEED_APPROACH, <= full     */
+    uint16_t accel_ms;              /**< 0 to full_duty; 0 = at once                   */
+    uint16_t decel_ms;              /**< full_duty to 0; 0 = at once                   */
+    uint16_t step_hz;               /**< Rate of #actuator_ramp_step() calls (>= 1)    */
+} ActuatorRampConfig_t;
+
+/**
+ * @brief  Ramp state.
+ * @note   `request` and `target` are written by #actuator_ramp_set(), the
+ *         rest by #actuator_ramp_step(); callers in different interrupt
+ *         levels must not preempt each other.
+ */
+typedef struct {
+    ActuatorRampConfig_t config;
+    uint16_t          accel_step;   /**< Duty added per step                          */
+    uint16_t          decel_step;   /**< Duty removed per step                        */
+    ActuatorOutput_t  request;      /**< Direction asked for, STOP for none           */
+    uint16_t          target;       /**< Duty asked for in that direction             */
+    ActuatorOutput_t  direction;    /**< Direction being driven, STOP at duty 0       */
+    uint16_t          duty;         /**< Duty being driven                            */
+} ActuatorRamp_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Initialise a ramp at rest.
+ * @param  p_ramp  Ramp (out).
+ * @param  p_cfg   Settings.
+ * @return Non-zero on success, zero if `step_hz` or `full_duty` is 0, or
+ *         `approach_duty` exceeds `full_duty`.
+ */
+uint8_t actuator_ramp_init(ActuatorRamp_t *p_ramp, const ActuatorRampConfig_t *p_cfg);
+
+/**
+ * @brief  Request a direction and speed.
+ * @param  p_ramp  Ramp.
+ * @param  output  Direction; #ACTUATOR_OUTPUT_STOP ramps down to rest.
+ * @param  speed   Duty to ramp to; #ACTUATOR_SPEED_CUT sets the duty to 0
+ *                 at once before anything else.
+ */
+void actuator_ramp_set(ActuatorRamp_t *p_ramp, ActuatorOutput_t output, ActuatorSpeed_t speed);
+
+/**
+ * @brief  Advance the duty by one step towards the request.
+ * @param  p_ramp  Ramp.
+ * @return Non-zero while further steps are needed, 0 once the request is met.
+ */
+uint8_t actuator_ramp_step(ActuatorRamp_t *p_ramp);
+
+#endif /* ACTUATOR_RAMP_H */
@@ -0,0 +1,150 @@
+/**
+ * @file    actuator_storage.h
+ * @brief   Calibration persistence for the actuator control module.
+ *
+ * Keeps the homing result (travel times and last known position) in the last
+ * page of on-chip flash so that a power cycle does not cost a full homing.
+ *
+ * The page is used as an append-only log of fixed-size records: every save
+ * programs the next free slot, and the page is erased only when it is full.
+ * Each record carries a magic, a layout version and a CRC-32. A record also
+ * has an "in motion" half-word that is programmed to zero when the actuator
+ * starts moving; a record whose marker was cleared is stale, because power
+ * was lost before the move finished and the stored position can no longer
+ * be trusted.
+ *
+ * Erases and programs stall instruction fetch from flash, so records are
+ * only written while the whole group is at rest. New travel times (a
+ * homing) are written as soon as that is the case; a record that only
+ * moves the position waits until #ACTUATOR_STORAGE_SAVE_INTERVAL_MS after
+ * the previous one, which bounds the page erases however often the
+ * actuator moves. A power loss inside that window costs a homing, as a
+ * stale record does. Marking a record in motion is a single half-word
+ * program (about 50 us) and is the only write made while anything moves.
+ *
+ * @note    Uses HAL_FLASH and the `_calib_start` / `_calib_end` symbols from
+ *          the linker script; the host build emulates both in RAM
+ *          (Host/Src/stm32f1xx_hal_host.c).
+ */
+
+#ifndef ACTUATOR_STORAGE_H
+#define ACTUATOR_STORAGE_H
+
+#include <stdint.h>
+#include "actuator_control.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** Marks a programmed record ("ACAL"). */
+#define ACTUATOR_STORAGE_MAGIC      0x4C414341UL
+
+/** Bump whenever #ActuatorCalibRecord_t changes layout or meaning. */
+#define ACTUATOR_STORAGE_VERSION    1U
+
+/**
+ * @brief  Minimum time between two records with the same travel times, in
+ *         ticks: at most one page erase per 42 of these (about 42 minutes).
+ */
+#define ACTUATOR_STORAGE_SAVE_INTERVAL_MS   MS_TO_TICKS(60000U)
+
+/* -------------------------------------------------------------------------- */
+/*   Enumerations                                                             */
+/* -------------------------------------------------------------------------- */
+
+typedef enum {
+    ACTUATOR_STORAGE_OK = 0,            /**< Valid calibration loaded              */
+    ACTUATOR_STORAGE_EMPTY,             /**< No record written yet                 */
+    ACTUATOR_STORAGE_CORRUPT,           /**< Magic or CRC mismatch                 */
+    ACTUATOR_STORAGE_VERSION_MISMATCH,  /**< Written by another firmware layout    */
+    ACTUATOR_STORAGE_STALE,             /**< Power lost while the actuator moved   */
+    ACTUATOR_STORAGE_ERROR              /**< Flash erase / program failed          */
+} ActuatorStorageStatus_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  One flash record. Size is a multiple of 4 so slots stay aligned.
+ */
+typedef struct {
+    uint32_t magic;                     /**< #ACTUATOR_STORAGE_MAGIC               */
+    uint16_t version;                   /**< #ACTUATOR_STORAGE_VERSION             */
+    uint16_t position;                  /**< Position in permille                  */
+    uint32_t extend_time;               /**< Full-extend travel time (ticks)       */
+    uint32_t shrink_time;               /**< Full-shrink travel time (ticks)       */
+    uint32_t crc;                       /**< CRC-32 of all fields above            */
+    uint16_t in_motion;                 /**< 0xFFFF at rest, 0 once motion started */
+    uint16_t reserved;                  /**< Left erased                           */
+} ActuatorCalibRecord_t;
+
+/**
+ * @brief  Storage context.
+ */
+typedef struct {
+    uintptr_t slot_addr;                /**< Current record, 0 if none             */
+    uint32_t  extend_time;              /**< Travel times of the current record,   */
+    uint32_t  shrink_time;              /**< 0 if there is no valid one            */
+    uint32_t  save_time;                /**< Tick of the last write attempt        */
+    uint8_t   was_moving;               /**< Motion state seen on the last service */
+    uint8_t   motion_marked;            /**< Current record already marked stale   */
+    uint8_t   dirty;                    /**< Moved since the current record        */
+} ActuatorStorage_t;
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Find the newest record and, if it is valid, restore it into `p_act`.
+ * @param  p_store  Storage context (out).
+ * @param  p_act    Initialised actuator, idle.
+ * @return #ACTUATOR_STORAGE_OK when the actuator can skip homing.
+ */
+ActuatorStorageStatus_t actuator_storage_load(ActuatorStorage_t *p_store,
+                                              ActuatorControl_t *p_act);
+
+/**
+ * @brief  Append the current calibration and position as a new record.
+ * @note   Erases the page first when it is full (~20 ms on the F103), and
+ *         when programming the free slot fails — e.g. a slot whose magic
+ *         reads erased but whose other bits do not — before one retry at
+ *         the start of the page.
+ */
+ActuatorStorageStatus_t actuator_storage_save(ActuatorStorage_t *p_store,
+                                              const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Track motion and keep the flash in step with it. Call from the
+ *         main loop after actuator_update().
+ *
+ *         On rest -> moving the current record is marked in motion. Once
+ *         the actuator has moved and is at rest, calibrated and at a known
+ *         position, a new record is written while `group_idle` is set:
+ *         at once for new travel times, otherwise no sooner than
+ *         #ACTUATOR_STORAGE_SAVE_INTERVAL_MS after the last one.
+ * @param  p_store       Storage context.
+ * @param  p_act         Actuator whose calibration is stored.
+ * @param  group_idle    Non-zero if no actuator on the board is moving
+ *                       (#actuator_group_is_idle()).
+ * @param  current_time  Current tick.
+ */
+void actuator_storage_service(ActuatorStorage_t *p_store,
+                              const ActuatorControl_t *p_act,
+                              uint8_t group_idle,
+                              uint32_t current_time);
+
+/**
+ * @brief  Ticks until #actuator_storage_service() has a record to write.
+ * @return 0 if one is due now, #ACTUATOR_NO_DEADLINE if none is pending or
+ *         `group_idle` is clear (the update that stops the last actuator
+ *         runs the service anyway).
+ */
+uint32_t actuator_storage_next_deadline(const ActuatorStorage_t *p_store,
+                                        const ActuatorControl_t *p_act,
+                                        uint8_t group_idle,
+                                        uint32_t current_time);
+
+#endif /* ACTUATOR_STORAGE_H */
@@ -0,0 +1,150 @@
+/**
+ * @file    actuator_telemetry.h
+ * @brief   Fixed-size binary telemetry frames, double-buffered for DMA.
+ *
+ * Every `period` ticks one #ActuatorTelemetryFrame_t per actuator is written
+ * straight into one of two frame buffers, and that buffer is handed to the
+ * transmitter (USART1 TX DMA on the target) as is — there is no staging copy.
+ * The next sample goes into the other buffer, so the CPU never writes memory
+ * the DMA is still reading. If the previous transfer is still running when a
+ * sample is due, the sample is filled into the idle buffer anyway and queued;
+ * the first update after #actuator_telemetry_tx_done() sends it. Only a
+ * sample that falls due while one buffer is on the wire and the other is
+ * queued is dropped and counted.
+ *
+ * Filling a frame costs a few dozen cycles per actuator; ticks between
+ * samples cost one compare.
+ *
+ * While all actuators are at rest (#actuator_telemetry_set_idle()) one more
+ * sample is sent, then none until motion resumes, so telemetry keeps no
+ * deadline armed and the main loop can enter STOP mode.
+ *
+ * @note    HAL-agnostic; the transmitter is a callback.
+ */
+
+#ifndef ACTUATOR_TELEMETRY_H
+#define ACTUATOR_TELEMETRY_H
+
+#include <stdint.h>
+#include "actuator_control.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** First half-word of every frame, 0xA5 0x5A on the wire. */
+#define ACTUATOR_TELEMETRY_SYNC         0x5AA5U
+
+/** Bump whenever #ActuatorTelemetryFrame_t changes layout or meaning. */
+#define ACTUATOR_TELEMETRY_VERSION      1U
+
+/** Frames per buffer — one per actuator. */
+#define ACTUATOR_TELEMETRY_MAX_FRAMES   4U
+
+/** `homing` byte: bit 7 set while homing, low bits are the HomingPhase_t. */
+#define ACTUATOR_TELEMETRY_HOMING       0x80U
+
+/** `switches` byte: debounced limit-switch states. */
+#define ACTUATOR_TELEMETRY_EXTEND_SW    0x01U
+#define ACTUATOR_TELEMETRY_SHRINK_SW    0x02U
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  One frame, 24 bytes, little-endian, no padding.
+ * @note   `checksum` makes the 8-bit sum of all 24 bytes zero.
+ */
+typedef struct {
+    uint16_t sync;                      /**< #ACTUATOR_TELEMETRY_SYNC              */
+    uint8_t  index;                     /**< Actuator index                         */
+    uint8_t  state;                     /**< ActuatorState_t                        */
+    uint8_t  homing;                    /**< HomingPhase_t | #ACTUATOR_TELEMETRY_HOMING */
+    uint8_t  switches;                  /**< ACTUATOR_TELEMETRY_*_SW bits           */
+    uint16_t position;                  /**< Permille, or ACTUATOR_POSITION_UNKNOWN */
+    uint32_t tick;                      /**< Tick of the sample                     */
+    uint32_t extend_time;               /**< Measured full-extend time (ticks)      */
+    uint32_t shrink_time;               /**< Measured full-shrink time (ticks)      */
+    uint16_t sequence;                  /**< Sample counter, to spot lost frames    */
+    uint8_t  version;                   /**< #ACTUATOR_TELEMETRY_VERSION            */
+    uint8_t  checksum;                  /**< Two's complement of the byte sum       */
+} ActuatorTelemetryFrame_t;
+
+/**
+ * @brief  Start sending `length` bytes without blocking.
+ * @return Non-zero if the transfer started. The transmitter must call
+ *         #actuator_telemetry_tx_done() when it has finished.
+ */
+typedef uint8_t (*ActuatorTelemetryTx_t)(const uint8_t *p_data, uint16_t length);
+
+/**
+ * @brief  Telemetry state. All state is held here.
+ */
+typedef struct {
+    ActuatorTelemetryFrame_t frames[2][ACTUATOR_TELEMETRY_MAX_FRAMES]; /**< Ping-pong buffers */
+    uint8_t                  fill;          /**< Buffer the next sample is written to         */
+    volatile uint8_t         tx_busy;       /**< Set when handed to the DMA, cleared on done  */
+    volatile uint16_t        queued;        /**< Bytes waiting in the other buffer, 0 if none */
+    uint16_t                 sequence;      /**< Next sample number                           */
+    uint32_t                 period;        /**< Ticks between samples; 0 = off               */
+    uint32_t                 next_time;     /**< Tick of the next sample                      */
+    uint32_t                 dropped;       /**< Samples skipped with both buffers taken      */
+    uint8_t                  idle;          /**< All actuators at rest                        */
+    uint8_t                  idle_sent;     /**< A sample taken at rest went out              */
+    ActuatorTelemetryTx_t    p_tx;          /**< Transmitter                                  */
+} ActuatorTelemetry_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Initialise telemetry.
+ * @param  p_tel         Telemetry state (out).
+ * @param  period        Ticks between samples; 0 disables telemetry.
+ * @param  p_tx          Transmitter.
+ * @param  current_time  Tick of the first sample.
+ */
+void actuator_telemetry_init(ActuatorTelemetry_t *p_tel,
+                             uint32_t period,
+                             ActuatorTelemetryTx_t p_tx,
+                             uint32_t current_time);
+
+/**
+ * @brief  Sample and send, if a sample is due — call right after the
+ *         actuators are updated.
+ * @param  p_tel         Telemetry state.
+ * @param  p_acts        Array of `count` actuators.
+ * @param  count         Number of actuators (extra ones are not sent).
+ * @param  current_time  Current tick.
+ */
+void actuator_telemetry_update(ActuatorTelemetry_t *p_tel,
+                               const ActuatorControl_t *p_acts,
+                               uint8_t count,
+                               uint32_t current_time);
+
+/**
+ * @brief  Report whether all actuators are at rest — call before
+ *         #actuator_telemetry_update(). At rest, samples stop after the
+ *         next one; when motion resumes a sample is due at once.
+ * @param  p_tel         Telemetry state.
+ * @param  idle          Non-zero if no actuator moves or homes.
+ * @param  current_time  Current tick.
+ */
+void actuator_telemetry_set_idle(ActuatorTelemetry_t *p_tel, uint8_t idle, uint32_t current_time);
+
+/**
+ * @brief  Transfer-complete notification — call from the TX DMA interrupt.
+ * @return Non-zero if a queued buffer is waiting: wake the main loop so
+ *         that #actuator_telemetry_update() sends it.
+ */
+uint8_t actuator_telemetry_tx_done(ActuatorTelemetry_t *p_tel);
+
+/**
+ * @brief  Ticks until the next sample is due, or #ACTUATOR_NO_DEADLINE if off
+ *         or paused at rest; 0 while a queued buffer can be sent.
+ */
+uint32_t actuator_telemetry_next_deadline(const ActuatorTelemetry_t *p_tel, uint32_t current_time);
+
+#endif /* ACTUATOR_TELEMETRY_H */
@@ -0,0 +1,62 @@
+/**
+ * @file    actuator_timebase.h
+ * @brief   Free-running 32-bit microsecond clock from two chained timers,
+ *          with input capture of the limit-switch edges.
+ *
+ * TIM4 counts 1 MHz and is the low half; its update event clocks TIM3, the
+ * high half, through ITR3 — a 32-bit microsecond counter with no interrupt
+ * and no software overflow handling. PB7 and PB8 (the extend / shrink limit
+ * switches) are TIM4_CH2 and TIM4_CH3, so their rising edges are latched
+ * by hardware; the capture interrupt only extends the latched low half to
+ * 32 bits and hands it to #actuator_timebase_capture_callback().
+ *
+ * Pass #actuator_timebase_now_us() as ActuatorConfig_t::timestamp_us and
+ * forward the captures to actuator_switch_edge() to time homing travel to
+ * the microsecond instead of the tick.
+ *
+ * @note    Target only. Register-level set-up. The counters stop in STOP
+ *          mode. Captures rising edges — the board switches are active high.
+ */
+
+#ifndef ACTUATOR_TIMEBASE_H
+#define ACTUATOR_TIMEBASE_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** Counter frequency. */
+#define ACTUATOR_TIMEBASE_HZ        1000000UL
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Start TIM3/TIM4 from zero and enable the PB7/PB8 captures.
+ *         The pins keep their GPIO input configuration.
+ */
+void actuator_timebase_init(void);
+
+/**
+ * @brief  Current time in microseconds; wraps after about 71 minutes.
+ */
+uint32_t actuator_timebase_now_us(void);
+
+/**
+ * @brief  TIM4 interrupt body — call from TIM4_IRQHandler().
+ */
+void actuator_timebase_irq_handler(void);
+
+/**
+ * @brief  A limit-switch edge was captured. Called from the TIM4 interrupt.
+ * @param  port          Port of the edge (GPIOB, as `void*`).
+ * @param  gpio_pin      Pin of the edge (GPIO_PIN_7 or GPIO_PIN_8).
+ * @param  timestamp_us  Time of the edge on the #actuator_timebase_now_us() clock.
+ * @note   Weak; override in the application.
+ */
+void actuator_timebase_capture_callback(void *port, uint16_t gpio_pin, uint32_t timestamp_us);
+
+#endif /* ACTUATOR_TIMEBASE_H */
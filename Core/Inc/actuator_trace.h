@@ -0,0 +1,108 @@
+/**
+ * @file    actuator_trace.h
+ * @brief   State-transition trace: a RAM ring of the last
+ *          #ACTUATOR_TRACE_SIZE events, kept across a soft reset.
+ *
+ * Every state change, homing phase change, homing timeout, debounced
+ * limit-switch edge and queued command is appended as an 8-byte record with
+ * its tick. #actuator_trace lives in the `.noinit` section, so after a
+ * watchdog or software reset the history leading up to it is still there;
+ * read it with the debugger (e.g. `dump binary value trace.bin actuator_trace`)
+ * and decode it on the host with `actuator_trace_decode`.
+ *
+ * Records are written from the main loop only (actuator_update() and the
+ * commands it issues), so no locking is needed.
+ *
+ * Build with `-DACTUATOR_TRACE_ENABLED=0` to compile every ACTUATOR_TRACE_*
+ * macro to nothing.
+ */
+
+#ifndef ACTUATOR_TRACE_H
+#define ACTUATOR_TRACE_H
+
+#include <stdint.h>
+
+#ifndef ACTUATOR_TRACE_ENABLED
+#define ACTUATOR_TRACE_ENABLED      1U
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** Records kept — a power of two. */
+#define ACTUATOR_TRACE_SIZE         128U
+
+/** #ActuatorTrace_t::magic of a valid trace ("ATR1"). */
+#define ACTUATOR_TRACE_MAGIC        0x31525441UL
+
+/* -------------------------------------------------------------------------- */
+/*   Enumerations                                                             */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Record types and the meaning of their `arg`.
+ */
+typedef enum {
+    ACTUATOR_TRACE_BOOT    = 0,     /**< arg: reset flags (RCC_CSR bits 31..24)        */
+    ACTUATOR_TRACE_STATE   = 1,     /**< arg: new ActuatorState_t | old << 8           */
+    ACTUATOR_TRACE_PHASE   = 2,     /**< arg: new HomingPhase_t                        */
+    ACTUATOR_TRACE_TIMEOUT = 3,     /**< arg: HomingPhase_t that timed out             */
+    ACTUATOR_TRACE_SWITCH  = 4,     /**< arg: 0 extend / 1 shrink | pressed << 8       */
+    ACTUATOR_TRACE_STALL   = 5,     /**< arg: ActuatorState_t stalled | end stop << 8  */
+    ACTUATOR_TRACE_COMMAND = 16     /**< + ActuatorCommandType_t; arg: command argument */
+} ActuatorTraceEvent_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    uint32_t tick;                  /**< HAL tick of the event                 */
+    uint8_t  event;                 /**< ActuatorTraceEvent_t                  */
+    uint8_t  actuator;              /**< Actuator index (ActuatorControl_t::id) */
+    uint16_t arg;                   /**< Event-specific, see ActuatorTraceEvent_t */
+} ActuatorTraceRecord_t;
+
+typedef struct {
+    uint32_t              magic;    /**< #ACTUATOR_TRACE_MAGIC once initialised */
+    uint32_t              head;     /**< Records written since the trace was cleared */
+    ActuatorTraceRecord_t records[ACTUATOR_TRACE_SIZE]; /**< Slot `head % SIZE` is next */
+} ActuatorTrace_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Macros                                                                   */
+/* -------------------------------------------------------------------------- */
+
+#if ACTUATOR_TRACE_ENABLED
+
+/** The trace, in `.noinit`. */
+extern ActuatorTrace_t actuator_trace;
+
+/** Append a record for actuator `p_act`. */
+#define ACTUATOR_TRACE(p_act, event, arg)                                   \
+    actuator_trace_record((p_act)->id, (uint8_t)(event), (uint16_t)(arg))
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Keep the trace if it survived a reset, clear it otherwise, and
+ *         append a #ACTUATOR_TRACE_BOOT record.
+ * @param  reset_flags  Reset cause, stored in the boot record.
+ */
+void actuator_trace_init(uint8_t reset_flags);
+
+/**
+ * @brief  Append one record, overwriting the oldest when full.
+ */
+void actuator_trace_record(uint8_t actuator, uint8_t event, uint16_t arg);
+
+#else
+
+#define ACTUATOR_TRACE(p_act, event, arg)   ((void)0)
+
+#endif /* ACTUATOR_TRACE_ENABLED */
+
+#endif /* ACTUATOR_TRACE_H */
@@ -16,6 +16,10 @@
 
 #include <stdint.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*   Type definitions                                                         */
 /* -------------------------------------------------------------------------- */
@@ -36,6 +40,33 @@ typedef struct {
     uint8_t  just_released;         /**< Set for one cycle after release detected*/
 } ButtonDebounce_t;
 
+/**
+ * @brief  Maximum number of consecutive samples #ButtonDebouncePort_t can
+ *         require (three counter bit-planes).
+ */
+#define BUTTON_DEBOUNCE_PORT_MAX_SAMPLES    7U
+
+/**
+ * @brief  Debouncer for up to 16 pins of one GPIO port.
+ * @note   Bit n of every field belongs to pin n. Each pin has a 3-bit
+ *         counter stored "vertically" across `count0..count2`, so one update
+ *         advances all 16 counters with a handful of word-wide operations.
+ *         A pin changes its stable state after `samples` consecutive updates
+ *         that disagree with it — unlike #ButtonDebounce_t this is sample
+ *         based, so call #button_debounce_port_update() at a fixed period.
+ */
+typedef struct {
+    uint16_t pin_mask;              /**< Pins handled by this instance           */
+    uint16_t invert_mask;           /**< Pins whose active level is LOW          */
+    uint16_t pressed;               /**< Debounced pressed state                 */
+    uint16_t count0;                /**< Counter bit 0, per pin                  */
+    uint16_t count1;                /**< Counter bit 1, per pin                  */
+    uint16_t count2;                /**< Counter bit 2, per pin                  */
+    uint16_t samples_mask[3];       /**< `samples` spread over the bit-planes    */
+    uint16_t just_pressed;          /**< Pins pressed by the last update         */
+    uint16_t just_released;         /**< Pins released by the last update        */
+} ButtonDebouncePort_t;
+
 /* -------------------------------------------------------------------------- */
 /*   Public API                                                               */
 /* -------------------------------------------------------------------------- */
@@ -64,6 +95,21 @@ void button_debounce_update(ButtonDebounce_t *p_btn,
                             uint8_t raw_state,
                             uint32_t current_time);
 
+/**
+ * @brief  Load a state that was debounced elsewhere (e.g. by a
+ *         #ButtonDebouncePort_t) — no filtering; the one-cycle edge flags
+ *         are computed as in #button_debounce_update(). The raw level is
+ *         kept with the tick of its last change, as the update does.
+ * @param  p_btn          Pointer to the ButtonDebounce_t struct (in/out).
+ * @param  pressed        Non-zero if the input is debounced pressed.
+ * @param  raw_state      Current raw (undebounced) logic level from GPIO.
+ * @param  current_time   Current system tick (e.g. HAL_GetTick()).
+ */
+void button_debounce_set(ButtonDebounce_t *p_btn,
+                         uint8_t pressed,
+                         uint8_t raw_state,
+                         uint32_t current_time);
+
 /**
  * @brief  Return 1 if the button is currently in the pressed (stable) state.
  * @param  p_btn  Pointer to the ButtonDebounce_t struct (read-only).
@@ -87,4 +133,53 @@ uint8_t button_debounce_just_pressed(const ButtonDebounce_t *p_btn);
  */
 uint8_t button_debounce_just_released(const ButtonDebounce_t *p_btn);
 
+/* -------------------------------------------------------------------------- */
+/*   Port-wide API                                                            */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Initialise a port debouncer; all pins start released.
+ * @param  p_port            Pointer to the ButtonDebouncePort_t struct (out).
+ * @param  pin_mask          Pins to debounce (GPIO_PIN_x masks OR-ed).
+ * @param  active_high_mask  Pins that are pressed when HIGH; the other pins
+ *                           of `pin_mask` are pressed when LOW.
+ * @param  samples           Consecutive agreeing samples needed to change
+ *                           state, 1..#BUTTON_DEBOUNCE_PORT_MAX_SAMPLES.
+ */
+void button_debounce_port_init(ButtonDebouncePort_t *p_port,
+                               uint16_t pin_mask,
+                               uint16_t active_high_mask,
+                               uint8_t samples);
+
+/**
+ * @brief  Feed one sample of the port and debounce all pins at once.
+ *         Recomputes the one-cycle edge masks.
+ * @param  p_port  Pointer to the ButtonDebouncePort_t struct (in/out).
+ * @param  idr     Raw input data register value of the port.
+ * @return Debounced pressed mask (same as #button_debounce_port_pressed()).
+ */
+uint16_t button_debounce_port_update(ButtonDebouncePort_t *p_port, uint16_t idr);
+
+/**
+ * @brief  Return the mask of pins currently in the pressed (stable) state.
+ * @param  p_port  Pointer to the ButtonDebouncePort_t struct (read-only).
+ */
+uint16_t button_debounce_port_pressed(const ButtonDebouncePort_t *p_port);
+
+/**
+ * @brief  Return the mask of pins pressed by the last update.
+ * @param  p_port  Pointer to the ButtonDebouncePort_t struct (read-only).
+ */
+uint16_t button_debounce_port_just_pressed(const ButtonDebouncePort_t *p_port);
+
+/**
+ * @brief  Return the mask of pins released by the last update.
+ * @param  p_port  Pointer to the ButtonDebouncePort_t struct (read-only).
+ */
+uint16_t button_debounce_port_just_released(const ButtonDebouncePort_t *p_port);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* BUTTON_DEBOUNCE_H */
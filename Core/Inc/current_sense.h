@@ -0,0 +1,79 @@
+/**
+ * @file    current_sense.h
+ * @brief   Motor current on ADC1 channel 4 (PA4), sampled continuously into
+ *          a circular DMA ring.
+ *
+ * ADC1 converts PA4 back to back (12 MHz ADC clock, 239.5-cycle sample
+ * time: #CURRENT_SENSE_SAMPLE_HZ) and DMA1 channel 1 writes every result
+ * into #CURRENT_SENSE_RING_SIZE half-words of RAM without CPU involvement.
+ * The half- and full-transfer interrupts call
+ * #current_sense_block_callback() once per half ring, where the stall
+ * detector (actuator_current.h) reads the new samples in place:
+ *
+ * @code
+ * actuator_current_process(&s_current, current_sense_position());
+ * @endcode
+ *
+ * The shunt amplifier output is expected on PA4, 0..3.3 V; the threshold
+ * of the detector is in raw ADC counts.
+ *
+ * @note    Target only. Register-level ADC and DMA set-up, like
+ *          actuator_timebase.h. The ADC stops in STOP mode.
+ */
+
+#ifndef CURRENT_SENSE_H
+#define CURRENT_SENSE_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** DMA ring size in samples — a power of two, as required by the detector. */
+#define CURRENT_SENSE_RING_SIZE     128U
+
+/** Conversion rate: 12 MHz / (239.5 + 12.5) cycles. */
+#define CURRENT_SENSE_SAMPLE_HZ     47619UL
+
+/** Detector block: 2^5 samples, about 0.67 ms. */
+#define CURRENT_SENSE_BLOCK_SHIFT   5U
+
+/** Milliseconds to detector blocks, rounded up. */
+#define CURRENT_SENSE_MS_TO_BLOCKS(ms)                                          \
+    ((uint16_t)((((uint32_t)(ms) * CURRENT_SENSE_SAMPLE_HZ) +                   \
+                 (1000UL << CURRENT_SENSE_BLOCK_SHIFT) - 1UL) /                 \
+                (1000UL << CURRENT_SENSE_BLOCK_SHIFT)))
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Configure PA4, ADC1 and DMA1 channel 1, calibrate the ADC and
+ *         start converting.
+ */
+void current_sense_init(void);
+
+/**
+ * @brief  Sample ring filled by DMA.
+ */
+const volatile uint16_t *current_sense_buffer(void);
+
+/**
+ * @brief  Offset of the next sample the DMA writes, 0..RING_SIZE-1.
+ */
+uint16_t current_sense_position(void);
+
+/**
+ * @brief  DMA1 channel 1 interrupt body — call from DMA1_Channel1_IRQHandler().
+ */
+void current_sense_irq_handler(void);
+
+/**
+ * @brief  Half the ring was filled. Called from the DMA interrupt.
+ * @note   Weak; override in the application.
+ */
+void current_sense_block_callback(void);
+
+#endif /* CURRENT_SENSE_H */
@@ -40,6 +40,7 @@ extern "C" {
 void MX_GPIO_Init(void);
 
 /* USER CODE BEGIN Prototypes */
+void MX_GPIO_LimitSwitchExti_Init(void);
 
 /* USER CODE END Prototypes */
 
@@ -72,6 +72,40 @@ void Error_Handler(void);
 
 /* USER CODE BEGIN Private defines */
 
+/* Limit switches stop the relays from EXTI (1) or only by polling (0) */
+#define LIMIT_SWITCH_EXTI_ENABLED   1U
+#define LIMIT_SWITCH_EXTI_PRIORITY  0U   /* Above SysTick (TICK_INT_PRIORITY) */
+
+/* Homing travel timed from TIM4 input capture of PB7/PB8 on a 1 MHz
+   TIM4 + TIM3 clock (1), or from SysTick ticks (0) */
+#define ACTUATOR_TIMEBASE_ENABLED   1U
+
+/* Quadrature encoder on PA0 / PA1 counted by TIM2; moves and the park stop
+   on the count (1), or positions are dead-reckoned from travel times (0) */
+#define ACTUATOR_ENCODER_ENABLED    0U
+#define ACTUATOR_ENCODER_INVERTED   0U     /* 1 if the count falls while extending */
+
+/* Motor current on PA4 (ADC1 + DMA1 channel 1) checked for stalls (1), or not (0) */
+#define CURRENT_SENSE_ENABLED       0U
+#define CURRENT_STALL_THRESHOLD     1241U  /* ADC counts: 2 A at 0.5 V/A, 3.3 V full scale */
+#define CURRENT_STALL_BLANK_MS      100U   /* Inrush ignored after each start          */
+#define CURRENT_STALL_TIME_MS       2U     /* Over the threshold this long is a stall  */
+#define CURRENT_STALL_END_STOP      0U     /* Stall ends travel (1, no switches) or is a jam (0) */
+
+/* H-bridge on PA8 / PA11 (TIM1 CH1 / CH4, 20 kHz PWM) with soft start and
+   stop ramps (1), or the relays on PB0 / PB1 (0) */
+#define ACTUATOR_BRIDGE_ENABLED     0U
+#define ACTUATOR_BRIDGE_ACCEL_MS    200U   /* Rest to full duty                        */
+#define ACTUATOR_BRIDGE_DECEL_MS    100U   /* Full duty to rest; also the reversal gap */
+#define ACTUATOR_BRIDGE_APPROACH_PCT 25U   /* Duty near an end stop                    */
+#define ACTUATOR_APPROACH_PERMILLE  100U   /* Length of that zone, permille of stroke  */
+
+/* Text commands on USART1, PA9 TX / PA10 RX (1), or none (0) */
+#define UART_COMMAND_ENABLED        1U
+
+/* Telemetry frames on USART1 TX every N ms (0 = off); needs UART_COMMAND_ENABLED */
+#define UART_TELEMETRY_PERIOD_MS    100U
+
 /* USER CODE END Private defines */
 
 #ifdef __cplusplus
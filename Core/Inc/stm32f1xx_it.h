@@ -56,6 +56,14 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 /* USER CODE BEGIN EFP */
+void EXTI9_5_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+void TIM1_UP_IRQHandler(void);
+void TIM2_IRQHandler(void);
+void TIM4_IRQHandler(void);
+void DMA1_Channel1_IRQHandler(void);
+void DMA1_Channel4_IRQHandler(void);
+void USART1_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,112 @@
+/**
+ * @file    uart_command.h
+ * @brief   USART1 command channel: circular DMA receive with idle-line wake-up,
+ *          DMA transmit for telemetry.
+ *
+ * USART1 (PA9 TX, PA10 RX, 115200 8N1) writes every received byte into
+ * #UART_COMMAND_RX_SIZE bytes of RAM through DMA1 channel 5 in circular
+ * mode; the CPU never touches the bytes on arrival. The idle-line interrupt
+ * fires once per burst and calls #uart_command_idle_callback(), which runs
+ * the parser (actuator_command.h) directly on the ring and posts each
+ * decoded command with actuator_post() — still in the ISR, the single
+ * producer of the actuator queues; the main loop only drains them.
+ * Transmit goes through DMA1 channel 4 straight from the caller's buffer,
+ * which must stay untouched until #uart_command_tx_done_callback().
+ *
+ * USART1 is not clocked in STOP mode. #uart_command_prepare_stop() arms PA10
+ * as a falling-edge EXTI line, so the start bit of the first byte wakes the
+ * core, and #uart_command_resume() restarts the receiver once the clocks
+ * are back. The bytes that arrive before that are lost, so a host sends a
+ * wake-up line (e.g. a bare `\n`) and waits about 5 ms before a command.
+ *
+ * @note    Target only. Register-level USART set-up — the HAL UART driver is
+ *          not part of this project; DMA goes through HAL_DMA.
+ */
+
+#ifndef UART_COMMAND_H
+#define UART_COMMAND_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** Receive ring size — a power of two, as required by the parser. */
+#define UART_COMMAND_RX_SIZE        128U
+
+#define UART_COMMAND_BAUDRATE       115200U
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Configure PA9/PA10, USART1 and DMA1 channel 5, and start receiving.
+ */
+void uart_command_init(void);
+
+/**
+ * @brief  Receive ring filled by DMA.
+ */
+const volatile uint8_t *uart_command_rx_buffer(void);
+
+/**
+ * @brief  Offset at which DMA writes the next byte (0..RX_SIZE-1).
+ */
+uint16_t uart_command_rx_position(void);
+
+/**
+ * @brief  USART1 interrupt body — call from USART1_IRQHandler().
+ */
+void uart_command_irq_handler(void);
+
+/**
+ * @brief  Arm PA10 (EXTI10, falling edge) as the STOP-mode wake-up source
+ *         and hold off the USART1 interrupt until #uart_command_resume().
+ *         Call with interrupts masked, right before entering STOP.
+ * @return Non-zero if armed; zero if a transmit is still going out, in
+ *         which case STOP must not be entered.
+ */
+uint8_t uart_command_prepare_stop(void);
+
+/**
+ * @brief  Disarm the wake-up line and restart the receiver after STOP —
+ *         call once the system clock is restored. The byte that woke the
+ *         core was sampled unclocked and is discarded with the ring.
+ * @note   The ring restarts at offset 0 and the USART1 interrupt is enabled
+ *         again: call with interrupts masked and re-initialise the parser
+ *         before unmasking them.
+ */
+void uart_command_resume(void);
+
+/**
+ * @brief  EXTI line 10 interrupt body — call from EXTI15_10_IRQHandler().
+ */
+void uart_command_wake_irq_handler(void);
+
+/**
+ * @brief  Start sending `length` bytes from `p_data` by DMA.
+ * @return Non-zero if started, zero if a transfer is still running.
+ */
+uint8_t uart_command_transmit(const uint8_t *p_data, uint16_t length);
+
+/**
+ * @brief  DMA1 channel 4 interrupt body — call from DMA1_Channel4_IRQHandler().
+ */
+void uart_command_tx_irq_handler(void);
+
+/**
+ * @brief  Called from interrupt context when a transmit has completed.
+ *         Weak; override to release the buffer.
+ */
+void uart_command_tx_done_callback(void);
+
+/**
+ * @brief  Called from interrupt context when the line goes idle after a
+ *         burst of received bytes. Weak; override to parse the new lines
+ *         and post the commands, then wake the main loop.
+ */
+void uart_command_idle_callback(void);
+
+#endif /* UART_COMMAND_H */
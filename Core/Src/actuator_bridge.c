@@ -0,0 +1,132 @@
+/**
+ * @file    actuator_bridge.c
+ * @brief   TIM1 PWM on PA8/PA11 for an H-bridge, duty ramped from the update
+ *          interrupt through the preload registers.
+ */
+
+#include "actuator_bridge.h"
+
+#include "main.h"                   /* HAL, CMSIS */
+#include "actuator_ramfunc.h"
+#include "actuator_ramp.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/* Fixed by the pin map: TIM1_CH1 is PA8, TIM1_CH4 is PA11 (no remap) */
+#define BRIDGE_EXTEND_Pin           GPIO_PIN_8
+#define BRIDGE_SHRINK_Pin           GPIO_PIN_11
+#define BRIDGE_GPIO_Port            GPIOA
+
+/* TIM1 runs from APB2 at 72 MHz without prescaler: 3600 counts per period */
+#define BRIDGE_PERIOD               (72000000UL / ACTUATOR_BRIDGE_PWM_HZ)
+
+/* PWM periods per ramp step, as programmed into the repetition counter */
+#define BRIDGE_REPETITION           (ACTUATOR_BRIDGE_PWM_HZ / ACTUATOR_BRIDGE_STEP_HZ)
+
+/* Same level as the limit-switch EXTI: a cut from there never lands in
+   the middle of a ramp step */
+#define BRIDGE_IRQ_PRIORITY         0U
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static ActuatorRamp_t s_ramp;
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Load the ramp's duty into the channel of its direction, 0 into
+ *         the other. Preloaded: applied at the next update event.
+ */
+ACTUATOR_RAMFUNC
+static void bridge_write(void)
+{
+    const uint16_t duty = s_ramp.duty;
+
+    TIM1->CCR1 = (s_ramp.direction == ACTUATOR_OUTPUT_EXTEND) ? duty : 0U;
+    TIM1->CCR4 = (s_ramp.direction == ACTUATOR_OUTPUT_SHRINK) ? duty : 0U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void actuator_bridge_init(uint16_t accel_ms, uint16_t decel_ms, uint8_t approach_pct)
+{
+    GPIO_InitTypeDef gpio = {0};
+
+    const ActuatorRampConfig_t ramp_config = {
+        .full_duty     = (uint16_t)BRIDGE_PERIOD,
+        .approach_duty = (uint16_t)((BRIDGE_PERIOD * ((approach_pct > 100U) ? 100U : approach_pct)) / 100U),
+        .accel_ms      = accel_ms,
+        .decel_ms      = decel_ms,
+        .step_hz       = (uint16_t)ACTUATOR_BRIDGE_STEP_HZ
+    };
+    (void)actuator_ramp_init(&s_ramp, &ramp_config);
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_TIM1_CLK_ENABLE();
+
+    /* ---- TIM1: edge-aligned PWM, CH1 and CH4 preloaded, both at 0 % ---- */
+    TIM1->CR1   = 0U;
+    TIM1->PSC   = 0U;
+    TIM1->ARR   = BRIDGE_PERIOD - 1U;
+    TIM1->RCR   = BRIDGE_REPETITION - 1U;
+    TIM1->CCMR1 = TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1PE;   /* PWM mode 1 */
+    TIM1->CCMR2 = TIM_CCMR2_OC4M_1 | TIM_CCMR2_OC4M_2 | TIM_CCMR2_OC4PE;
+    TIM1->CCR1  = 0U;
+    TIM1->CCR4  = 0U;
+    TIM1->CCER  = TIM_CCER_CC1E | TIM_CCER_CC4E;
+    TIM1->BDTR  = TIM_BDTR_MOE;                                 /* Advanced timer: main output on */
+    TIM1->CR1   = TIM_CR1_ARPE | TIM_CR1_URS;                   /* UG loads without an interrupt */
+    TIM1->EGR   = TIM_EGR_UG;
+    TIM1->SR    = 0U;
+    TIM1->DIER  = 0U;
+    TIM1->CR1  |= TIM_CR1_CEN;
+
+    /* ---- PA8 / PA11 alternate function, only once the outputs are low ---- */
+    gpio.Pin   = BRIDGE_EXTEND_Pin | BRIDGE_SHRINK_Pin;
+    gpio.Mode  = GPIO_MODE_AF_PP;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(BRIDGE_GPIO_Port, &gpio);
+
+    HAL_NVIC_SetPriority(TIM1_UP_IRQn, BRIDGE_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(TIM1_UP_IRQn);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_bridge_output(ActuatorOutput_t output, ActuatorSpeed_t speed)
+{
+    const uint32_t primask = __get_PRIMASK();
+
+    /* The ramp step runs at EXTI level; keep it out while the request changes */
+    __disable_irq();
+
+    actuator_ramp_set(&s_ramp, output, speed);
+    if (speed == ACTUATOR_SPEED_CUT) {
+        bridge_write();
+        TIM1->EGR = TIM_EGR_UG;         /* Apply 0 % now, not at the next update */
+    }
+    TIM1->DIER = TIM_DIER_UIE;          /* Step until the request is met */
+
+    __set_PRIMASK(primask);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_bridge_irq_handler(void)
+{
+    if ((TIM1->SR & TIM_SR_UIF) == 0U) {
+        return;
+    }
+
+    TIM1->SR = ~TIM_SR_UIF;
+    if (actuator_ramp_step(&s_ramp) == 0U) {
+        TIM1->DIER = 0U;                /* Request met: no interrupts until the next */
+    }
+    bridge_write();
+}
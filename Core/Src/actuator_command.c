@@ -0,0 +1,264 @@
+/**
+ * @file    actuator_command.c
+ * @brief   Text command parser for the actuator, reading straight from a
+ *          circular receive buffer.
+ *
+ * Tokens are never extracted into a separate buffer: the line is walked with
+ * a ring cursor and keywords are compared byte by byte against the ring.
+ */
+
+#include "actuator_command.h"
+#include "actuator_ramfunc.h"       /* Apply in SRAM on the target */
+
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Private types                                                            */
+/* -------------------------------------------------------------------------- */
+
+/** Cursor over one line [pos, end) of the ring. */
+typedef struct {
+    const CommandParser_t *p_parser;
+    uint16_t               pos;
+    uint16_t               end;
+} CommandCursor_t;
+
+typedef struct {
+    const char            *p_keyword;
+    ActuatorCommandType_t  type;
+} CommandKeyword_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+static const CommandKeyword_t s_keywords[] = {
+    { "EXTEND", ACTUATOR_CMD_EXTEND  },
+    { "SHRINK", ACTUATOR_CMD_SHRINK  },
+    { "STOP",   ACTUATOR_CMD_STOP    },
+    { "HOME",   ACTUATOR_CMD_HOME    },
+    { "MOVE",   ACTUATOR_CMD_MOVE_TO },
+};
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t is_line_end(uint8_t c)
+{
+    return ((c == (uint8_t)'\n') || (c == (uint8_t)'\r')) ? 1U : 0U;
+}
+
+static uint8_t cursor_peek(const CommandCursor_t *p_cur)
+{
+    return p_cur->p_parser->p_buf[p_cur->pos];
+}
+
+static uint8_t cursor_at_end(const CommandCursor_t *p_cur)
+{
+    return (p_cur->pos == p_cur->end) ? 1U : 0U;
+}
+
+static void cursor_advance(CommandCursor_t *p_cur)
+{
+    p_cur->pos = (uint16_t)((p_cur->pos + 1U) & p_cur->p_parser->mask);
+}
+
+static void cursor_skip_blanks(CommandCursor_t *p_cur)
+{
+    while ((cursor_at_end(p_cur) == 0U) &&
+           ((cursor_peek(p_cur) == (uint8_t)' ') || (cursor_peek(p_cur) == (uint8_t)'\t'))) {
+        cursor_advance(p_cur);
+    }
+}
+
+/** Match `p_keyword` (upper case) followed by a blank or the line end. */
+static uint8_t cursor_match(CommandCursor_t *p_cur, const char *p_keyword)
+{
+    CommandCursor_t probe = *p_cur;
+
+    while (*p_keyword != '\0') {
+        if (cursor_at_end(&probe) != 0U) {
+            return 0U;
+        }
+        uint8_t c = cursor_peek(&probe);
+        if ((c >= (uint8_t)'a') && (c <= (uint8_t)'z')) {
+            c = (uint8_t)(c - ((uint8_t)'a' - (uint8_t)'A'));
+        }
+        if (c != (uint8_t)*p_keyword) {
+            return 0U;
+        }
+        cursor_advance(&probe);
+        p_keyword++;
+    }
+
+    if ((cursor_at_end(&probe) == 0U) &&
+        (cursor_peek(&probe) != (uint8_t)' ') && (cursor_peek(&probe) != (uint8_t)'\t')) {
+        return 0U;
+    }
+    *p_cur = probe;
+    return 1U;
+}
+
+/**
+ * @brief  Parse an unsigned decimal number of at most 5 digits.
+ * @return Non-zero on success.
+ */
+static uint8_t cursor_number(CommandCursor_t *p_cur, uint16_t *p_value)
+{
+    uint32_t value  = 0U;
+    uint8_t  digits = 0U;
+
+    while ((cursor_at_end(p_cur) == 0U) &&
+           (cursor_peek(p_cur) >= (uint8_t)'0') && (cursor_peek(p_cur) <= (uint8_t)'9')) {
+        value = (value * 10U) + (uint32_t)(cursor_peek(p_cur) - (uint8_t)'0');
+        cursor_advance(p_cur);
+        if ((++digits > 5U) || (value > 0xFFFFU)) {
+            return 0U;
+        }
+    }
+    if (digits == 0U) {
+        return 0U;
+    }
+    *p_value = (uint16_t)value;
+    return 1U;
+}
+
+static void parse_line(CommandCursor_t *p_cur, ActuatorCommand_t *p_cmd)
+{
+    uint16_t value;
+
+    p_cmd->type     = ACTUATOR_CMD_INVALID;
+    p_cmd->index    = 0U;
+    p_cmd->argument = 0U;
+
+    cursor_skip_blanks(p_cur);
+    if (cursor_at_end(p_cur) != 0U) {
+        p_cmd->type = ACTUATOR_CMD_NONE;
+        return;
+    }
+
+    ActuatorCommandType_t type = ACTUATOR_CMD_INVALID;
+    for (size_t i = 0U; i < (sizeof(s_keywords) / sizeof(s_keywords[0])); i++) {
+        if (cursor_match(p_cur, s_keywords[i].p_keyword) != 0U) {
+            type = s_keywords[i].type;
+            break;
+        }
+    }
+    if (type == ACTUATOR_CMD_INVALID) {
+        return;
+    }
+
+    if (type == ACTUATOR_CMD_MOVE_TO) {
+        cursor_skip_blanks(p_cur);
+        if ((cursor_number(p_cur, &value) == 0U) || (value > ACTUATOR_POSITION_MAX)) {
+            return;
+        }
+        p_cmd->argument = value;
+    }
+
+    cursor_skip_blanks(p_cur);
+    if (cursor_at_end(p_cur) == 0U) {
+        if ((cursor_number(p_cur, &value) == 0U) || (value > 0xFFU)) {
+            return;
+        }
+        p_cmd->index = (uint8_t)value;
+        cursor_skip_blanks(p_cur);
+        if (cursor_at_end(p_cur) == 0U) {
+            return;                         /* Trailing garbage */
+        }
+    }
+
+    p_cmd->type = type;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+uint8_t command_parser_init(CommandParser_t *p_parser,
+                            const volatile uint8_t *p_buf,
+                            uint16_t size)
+{
+    if ((p_parser == NULL) || (p_buf == NULL) ||
+        (size < 2U) || ((size & (uint16_t)(size - 1U)) != 0U)) {
+        return 0U;
+    }
+
+    p_parser->p_buf    = p_buf;
+    p_parser->mask     = (uint16_t)(size - 1U);
+    p_parser->read_pos = 0U;
+    p_parser->scan_pos = 0U;
+    return 1U;
+}
+
+uint8_t command_parser_next(CommandParser_t *p_parser,
+                            uint16_t write_pos,
+                            ActuatorCommand_t *p_cmd)
+{
+    if ((p_parser == NULL) || (p_cmd == NULL)) {
+        return 0U;
+    }
+
+    const uint16_t mask = p_parser->mask;
+    write_pos &= mask;
+
+    /* ---- Find the end of the current line; resume where the last call stopped ---- */
+    while (p_parser->scan_pos != write_pos) {
+        const uint16_t pos = p_parser->scan_pos;
+        p_parser->scan_pos = (uint16_t)((pos + 1U) & mask);
+
+        if (is_line_end(p_parser->p_buf[pos]) != 0U) {
+            CommandCursor_t cur = { p_parser, p_parser->read_pos, pos };
+            parse_line(&cur, p_cmd);
+            p_parser->read_pos = p_parser->scan_pos;
+            return 1U;
+        }
+
+        /* ---- Line as long as the ring: it can never complete ---- */
+        if (p_parser->scan_pos == p_parser->read_pos) {
+            p_cmd->type     = ACTUATOR_CMD_INVALID;
+            p_cmd->index    = 0U;
+            p_cmd->argument = 0U;
+            p_parser->read_pos = write_pos;
+            p_parser->scan_pos = write_pos;
+            return 1U;
+        }
+    }
+    return 0U;
+}
+
+ACTUATOR_RAMFUNC
+void actuator_command_apply(ActuatorControl_t *p_act, const ActuatorCommand_t *p_cmd)
+{
+    if ((p_act == NULL) || (p_cmd == NULL)) {
+        return;
+    }
+
+    switch (p_cmd->type) {
+        case ACTUATOR_CMD_EXTEND:
+            actuator_extend(p_act);
+            break;
+
+        case ACTUATOR_CMD_SHRINK:
+            actuator_shrink(p_act);
+            break;
+
+        case ACTUATOR_CMD_STOP:
+            actuator_stop(p_act);
+            break;
+
+        case ACTUATOR_CMD_HOME:
+            actuator_start_homing(p_act);
+            break;
+
+        case ACTUATOR_CMD_MOVE_TO:
+            actuator_move_to(p_act, p_cmd->argument);
+            break;
+
+        case ACTUATOR_CMD_NONE:
+        case ACTUATOR_CMD_INVALID:
+            /* Nothing to do */
+            break;
+    }
+}
@@ -4,58 +4,437 @@
  *
  * Implements the full actuator lifecycle: extend, shrink, stop, and an
  * automatic homing routine that measures travel times and parks the actuator
- * at the midpoint.
+ * at a configurable fraction of the stroke.
  *
- * @note    GPIO port pointers arrive as `void*` from the HAL-agnostic config.
- *          They are cast to `GPIO_TypeDef*` at the last responsible moment.
+ * @note    GPIO port pointers arrive as `void*` from the HAL-agnostic config
+ *          and are only touched through the inline driver in actuator_gpio.h.
  */
 
 #include "actuator_control.h"
-#include "gpio.h"
-#include "stm32f1xx_hal.h"          /* HAL_GPIO_WritePin / ReadPin (only in .c) */
+#include "actuator_command.h"       /* actuator_command_apply() */
+#include "actuator_gpio.h"          /* Inline IDR / BSRR access (LL or HAL) */
+#include "actuator_profile.h"       /* Compiles to nothing unless enabled */
+#include "actuator_ramfunc.h"       /* Hot path in SRAM on the target */
+#include "actuator_trace.h"         /* Compiles to nothing when disabled */
 
 /* -------------------------------------------------------------------------- */
 /*   Private constants                                                        */
 /* -------------------------------------------------------------------------- */
 
+/** Values of ActuatorControl_t::limit_latch. */
+#define LIMIT_LATCH_NONE    0U      /**< No EXTI stop pending                     */
+#define LIMIT_LATCH_ISR     1U      /**< Set by the ISR, tick not yet recorded    */
+#define LIMIT_LATCH_ARMED   2U      /**< Tick recorded, awaiting debounce verdict */
+
+/** Values of ActuatorControl_t::relay_guard. */
+#define RELAY_GUARD_NONE     0U     /**< Either direction may be energised        */
+#define RELAY_GUARD_RELEASED 1U     /**< Relay released, tick not yet recorded    */
+#define RELAY_GUARD_ARMED    2U     /**< Tick recorded, dead time running         */
+
+/** Profile slot for an actuator_update() entered in the current state. */
+#define PROFILE_UPDATE_SLOT(p_act)                                              \
+    (((p_act)->is_homing != 0U) ? ACTUATOR_PROFILE_UPDATE_HOMING               \
+                                : (ActuatorProfileSlot_t)((uint32_t)ACTUATOR_PROFILE_UPDATE_IDLE + \
+                                                          (uint32_t)(p_act)->state))
+
+/* -------------------------------------------------------------------------- */
+/*   Transition table — types                                                 */
+/* -------------------------------------------------------------------------- */
+
+/** Row of the homing phases in #s_transitions; rows below are ActuatorState_t. */
+#define TRANSITION_ROW_HOMING       4U
+#define TRANSITION_ROWS             (TRANSITION_ROW_HOMING + 4U)
+
+/** Input bits forming the column of #s_transitions. */
+#define TRANSITION_IN_EXTEND        0x1U    /**< Extend switch pressed while extending  */
+#define TRANSITION_IN_SHRINK        0x2U    /**< Shrink switch pressed while shrinking  */
+#define TRANSITION_IN_TIMER         0x4U    /**< Move-to target / park time reached     */
+#define TRANSITION_INPUTS           8U
+
+/** ActuatorTransition_t::drive — command issued, index into #s_drive. */
+#define TRANSITION_DRIVE_KEEP       0U
+#define TRANSITION_DRIVE_STOP       1U
+#define TRANSITION_DRIVE_EXTEND     2U
+#define TRANSITION_DRIVE_SHRINK     3U
+
+/** ActuatorTransition_t::phase — a HomingPhase_t, or one of these. */
+#define TRANSITION_PHASE_KEEP       0xFEU   /**< Homing phase unchanged                 */
+#define TRANSITION_PHASE_DONE       0xFFU   /**< Homing sequence complete               */
+
+/** ActuatorTransition_t::measure — travel time that ends with this transition. */
+#define TRANSITION_MEASURE_NONE     0U
+#define TRANSITION_MEASURE_EXTEND   1U
+#define TRANSITION_MEASURE_SHRINK   2U
+
+/** ActuatorTransition_t::position — position afterwards, index into #s_positions. */
+#define TRANSITION_POS_KEEP         0U
+#define TRANSITION_POS_ZERO         1U
+#define TRANSITION_POS_MAX          2U
+#define TRANSITION_POS_PARK         3U      /**< ActuatorConfig_t::park_position        */
+#define TRANSITION_POS_TARGET       4U      /**< The move-to target                     */
+
 /**
- * @brief  Homing safety timeout.
- *         If a limit switch is not pressed within this many ticks after
- *         starting a homing move, the actuator enters the error state.
+ * @brief  What one update does for a given state, homing phase and inputs.
  */
-#define HOMING_TIMEOUT_MS   10000U
+typedef struct {
+    uint8_t drive;                  /**< TRANSITION_DRIVE_*           */
+    uint8_t phase;                  /**< Next phase, TRANSITION_PHASE_* */
+    uint8_t measure;                /**< TRANSITION_MEASURE_*         */
+    uint8_t position;               /**< TRANSITION_POS_*             */
+} ActuatorTransition_t;
 
 /* -------------------------------------------------------------------------- */
 /*   Private helpers — forward declarations                                   */
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief  Read and debounce both limit switches.
+ * @brief  Read both limit switches from their GPIO pins.
  * @param  p_act        Actuator control structure.
  * @param  current_time Current tick count.
  */
 static void update_switches(ActuatorControl_t *p_act, uint32_t current_time);
 
 /**
- * @brief  Run one iteration of the homing state machine.
+ * @brief  Everything #actuator_update() does once the switches are debounced.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void actuator_update_raw_debounced(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  First update of a homing run: enter #HOMING_PHASE_INIT.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void start_homing_sequence(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Abort homing into #ACTUATOR_ERROR if the phase ran too long.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void handle_homing_timeout(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Timeout of a homing phase: the learned time of the travel the
+ *         phase waits for plus ActuatorConfig_t::homing_margin_pct,
+ *         capped at ActuatorConfig_t::homing_timeout_ms. The fixed value
+ *         alone until a travel time has been learned.
+ * @param  p_act  Actuator control structure.
+ * @param  phase  Phase being entered.
+ * @return Timeout in ticks.
+ */
+static uint32_t homing_phase_timeout(const ActuatorControl_t *p_act, HomingPhase_t phase);
+
+/**
+ * @brief  Record the start lag of the EXTEND / SHRINK homing phase when the
+ *         switch it leaves is released.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void record_start_lag(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  How long to drive one way to cover `permille` of the stroke from
+ *         rest: the start lag, that share of the travel after it, less
+ *         ActuatorConfig_t::stop_lag_ms. Plain `travel` share while the
+ *         start lag is unknown.
+ *
+ *         `lag` is a debounced release and `travel` a debounced press when
+ *         timed in ticks, so their difference is free of debounce delay;
+ *         the lag itself is taken as `lag - debounce_time_ms`.
+ *
+ * @param  p_act    Actuator control structure.
+ * @param  travel   Full travel time in that direction, µs if `in_us`.
+ * @param  lag      extend_lag or shrink_lag, ticks.
+ * @param  in_us    Non-zero if `travel` and the result are in µs.
+ * @param  permille Share of the stroke.
+ * @return Drive time, in the unit of `travel`.
+ */
+static uint32_t drive_time(const ActuatorControl_t *p_act, uint32_t travel, uint32_t lag,
+                           uint8_t in_us, uint32_t permille);
+
+/**
+ * @brief  Non-zero if an encoder is configured and homing measured its span.
+ * @param  p_act  Actuator control structure.
+ */
+static uint8_t encoder_ready(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Encoder count at which to release the relay for a position:
+ *         the position's count, less the counts travelled during the stop
+ *         lag at the speed measured while homing.
+ * @param  p_act    Actuator control structure.
+ * @param  permille Position to stop at.
+ * @param  state    Direction of travel, #ACTUATOR_EXTENDING or #ACTUATOR_SHRINKING.
+ * @return Release count.
+ */
+static int32_t encoder_target(const ActuatorControl_t *p_act, uint16_t permille, ActuatorState_t state);
+
+/**
+ * @brief  Ticks until the next look at the encoder on the way to
+ *         `target_count`: half the time the rest takes at homing speed,
+ *         so a motor up to twice as fast still stops within a tick of it.
+ * @param  p_act  Actuator control structure.
+ * @return 0 if the count is reached, at least 1 otherwise.
+ */
+static uint32_t encoder_delay(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Record the count at an end stop: both ends while homing, and a
+ *         fresh reference for the zero count at every later arrival.
+ * @param  p_act     Actuator control structure.
+ * @param  measure   TRANSITION_MEASURE_* of the transition.
+ * @param  position  TRANSITION_POS_* of the transition.
+ */
+static void encoder_reference(ActuatorControl_t *p_act, uint8_t measure, uint8_t position);
+
+/**
+ * @brief  Look up and apply the #s_transitions entry for the current state,
+ *         homing phase, limit switches and timer.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void run_transition(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Confirm or release a stop issued by #actuator_limit_switch_isr().
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void handle_limit_latch(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  A stall the transition table did not take as an end stop: a jam.
+ *         Stop and enter #ACTUATOR_ERROR.
+ * @param  p_act  Actuator control structure.
+ */
+static void handle_stall(ActuatorControl_t *p_act);
+
+/**
+ * @brief  Run the relay dead time and energise the held-back direction
+ *         once it has passed; travel timing restarts from then.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void handle_relay_guard(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Travel time of the homing phase that ends now.
+ *
+ *         From the drive start to the captured switch edge when one is
+ *         available and plausible, otherwise from the phase start tick.
+ *
+ * @param  p_act        Actuator control structure.
+ * @param  edge_valid   Non-zero if `edge_us` was captured.
+ * @param  edge_us      First edge of the switch that ends the phase.
+ * @param  p_time_us    Travel time in µs (out), 0 if not edge-timed.
+ * @param  current_time Current tick count.
+ * @return Travel time in ticks.
+ */
+static uint32_t travel_time(const ActuatorControl_t *p_act,
+                            uint8_t edge_valid,
+                            uint32_t edge_us,
+                            uint32_t *p_time_us,
+                            uint32_t current_time);
+
+/**
+ * @brief  Trace the debounced limit-switch edges of the last update.
+ * @param  p_act  Actuator control structure.
+ */
+static void trace_switch_edges(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Issue every command posted since the last update.
+ * @param  p_act  Actuator control structure.
+ */
+static void drain_commands(ActuatorControl_t *p_act);
+
+/**
+ * @brief  Fold the travel since the start of the tracked segment into
+ *         `position`.
+ * @param  p_act        Actuator control structure.
+ * @param  current_time Current tick count.
+ */
+static void track_position(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Start a new tracked segment if the state changed since the last
+ *         one, and schedule the arrival at the move-to target.
  * @param  p_act        Actuator control structure.
  * @param  current_time Current tick count.
  */
-static void handle_homing_sequence(ActuatorControl_t *p_act, uint32_t current_time);
+static void sync_motion(ActuatorControl_t *p_act, uint32_t current_time);
+
+/**
+ * @brief  Energise one direction (or none) without touching the target.
+ * @param  p_act   Actuator control structure.
+ * @param  state   New state.
+ * @param  output  Output pattern matching `state`.
+ */
+static void drive(ActuatorControl_t *p_act, ActuatorState_t state, ActuatorOutput_t output);
+
+/**
+ * @brief  Restart the µs travel clock and forget captured switch edges.
+ * @param  p_act   Actuator control structure.
+ */
+static void stamp_drive_start(ActuatorControl_t *p_act);
+
+/**
+ * @brief  Break before make: hold back a direction opposite to the relay
+ *         released last until ActuatorConfig_t::relay_dead_time_ms has
+ *         passed (#handle_relay_guard()).
+ * @param  p_act   Actuator control structure.
+ * @param  output  Requested pattern.
+ * @return Pattern to apply now.
+ */
+static ActuatorOutput_t interlock_outputs(ActuatorControl_t *p_act, ActuatorOutput_t output);
+
+/**
+ * @brief  Select one of the precomputed output patterns. Written to the
+ *         ports at once, or left for #actuator_take_output() when deferred;
+ *         passed to ActuatorConfig_t::bridge_output in either case.
+ * @param  p_act   Actuator control structure.
+ * @param  output  Pattern to apply.
+ */
+static void set_outputs(ActuatorControl_t *p_act, ActuatorOutput_t output);
+
+/**
+ * @brief  Release the relays and cut the H-bridge from an interrupt, even
+ *         if outputs are deferred; the selected pattern is left alone.
+ * @param  p_act   Actuator control structure.
+ */
+static void cut_outputs(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Permille left to the end stop ahead of an end-stop travel (not
+ *         homing, which times full-speed strokes, and not a move to a
+ *         target, which is timed or counted at full speed).
+ * @param  p_act   Actuator control structure.
+ * @return Distance, or #ACTUATOR_POSITION_UNKNOWN if no approach applies.
+ */
+static uint16_t approach_left(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  #ACTUATOR_SPEED_APPROACH within ActuatorConfig_t::approach_permille
+ *         of the end stop ahead, #ACTUATOR_SPEED_FULL otherwise.
+ * @param  p_act   Actuator control structure.
+ */
+static ActuatorSpeed_t approach_speed(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Ticks until the approach zone is reached at homing speed; half
+ *         that with an encoder, which measures rather than estimates.
+ * @param  p_act   Actuator control structure.
+ * @return At least 1, or #ACTUATOR_NO_DEADLINE if no approach is ahead.
+ */
+static uint32_t approach_delay(const ActuatorControl_t *p_act);
+
+/**
+ * @brief  Tell the H-bridge when the travel enters or leaves the approach
+ *         zone. Not while an EXTI or stall stop holds the drive off.
+ * @param  p_act   Actuator control structure.
+ */
+static void update_speed(ActuatorControl_t *p_act);
+
+/**
+ * @brief  Write an output pattern to the ports — one BSRR store per port.
+ * @param  p_act   Actuator control structure.
+ * @param  output  Pattern to apply.
+ */
+static void write_outputs(const ActuatorControl_t *p_act, ActuatorOutput_t output);
+
+/**
+ * @brief  Shorten a deadline to an absolute due tick if that comes earlier.
+ * @param  delay         Current ticks-until-due.
+ * @param  due           Absolute tick at which something else is due.
+ * @param  current_time  Current tick count.
+ * @return The smaller of `delay` and the ticks left until `due` (0 if past).
+ */
+static uint32_t deadline_min(uint32_t delay, uint32_t due, uint32_t current_time);
+
+/**
+ * @brief  Merge one output pin into the per-port BSRR tables.
+ * @param  p_act   Actuator control structure.
+ * @param  port    GPIO port of the pin.
+ * @param  pin     GPIO pin mask.
+ * @param  levels  Pin level for each ActuatorOutput_t pattern.
+ */
+static void add_output_pin(ActuatorControl_t *p_act,
+                           void *port,
+                           uint16_t pin,
+                           const uint8_t levels[ACTUATOR_OUTPUT_COUNT]);
+
+/* -------------------------------------------------------------------------- */
+/*   Transition table — data (flash)                                          */
+/* -------------------------------------------------------------------------- */
+
+#define TR(drive, phase, measure, position)                                   \
+    { TRANSITION_DRIVE_##drive, (phase), TRANSITION_MEASURE_##measure, TRANSITION_POS_##position }
+
+#define TR_NONE         TR(KEEP, TRANSITION_PHASE_KEEP, NONE, KEEP)
+#define TR_STOP(pos)    TR(STOP, TRANSITION_PHASE_KEEP, NONE, pos)
+
+/** Switch input bits that can end travel in each ActuatorState_t. */
+static const uint8_t s_switch_ahead[] = {
+    0U,                             /* IDLE      */
+    TRANSITION_IN_EXTEND,           /* EXTENDING */
+    TRANSITION_IN_SHRINK,           /* SHRINKING */
+    0U                              /* ERROR     */
+};
+
+/** Commands behind TRANSITION_DRIVE_*. */
+static void (*const s_drive[])(ActuatorControl_t *p_act) = {
+    NULL, actuator_stop, actuator_extend, actuator_shrink
+};
+
+/** Positions behind TRANSITION_POS_* (KEEP, PARK and TARGET are not read). */
+static const uint16_t s_positions[] = {
+    ACTUATOR_POSITION_UNKNOWN, 0U, ACTUATOR_POSITION_MAX,
+    ACTUATOR_POSITION_UNKNOWN, ACTUATOR_POSITION_UNKNOWN
+};
 
 /**
- * @brief  Set a GPIO output pair and the two direction LEDs.
- * @param  p_act         Actuator control structure.
- * @param  extend_active Value for the extend control pin.
- * @param  shrink_active Value for the shrink control pin.
- * @param  led_extend    Value for the extend-direction LED.
- * @param  led_shrink    Value for the shrink-direction LED.
+ * @brief  The state machine: row = state, or homing phase while homing;
+ *         column = TRANSITION_IN_* bits. A switch beats the timer. The
+ *         EXTEND | SHRINK columns cannot occur (one direction at a time).
  */
-static void set_outputs(const ActuatorControl_t *p_act,
-                        uint8_t extend_active,
-                        uint8_t shrink_active,
-                        uint8_t led_extend,
-                        uint8_t led_shrink);
+static const ActuatorTransition_t s_transitions[TRANSITION_ROWS][TRANSITION_INPUTS] = {
+    /* Columns:  -, EXTEND, SHRINK, EXTEND|SHRINK, TIMER, TIMER|EXTEND, TIMER|SHRINK, all */
+    [ACTUATOR_IDLE] = {
+        TR_NONE,       TR_NONE,       TR_NONE,       TR_NONE,
+        TR_NONE,       TR_NONE,       TR_NONE,       TR_NONE },
+    [ACTUATOR_EXTENDING] = {
+        TR_NONE,       TR_STOP(MAX),  TR_NONE,       TR_NONE,
+        TR_STOP(TARGET), TR_STOP(MAX), TR_NONE,      TR_NONE },
+    [ACTUATOR_SHRINKING] = {
+        TR_NONE,       TR_NONE,       TR_STOP(ZERO), TR_NONE,
+        TR_STOP(TARGET), TR_NONE,     TR_STOP(ZERO), TR_NONE },
+    [ACTUATOR_ERROR] = {
+        TR_STOP(KEEP), TR_STOP(KEEP), TR_STOP(KEEP), TR_STOP(KEEP),
+        TR_STOP(KEEP), TR_STOP(KEEP), TR_STOP(KEEP), TR_STOP(KEEP) },
+
+    /* Home to the shrink stop, then time a full extend and a full shrink */
+    [TRANSITION_ROW_HOMING + HOMING_PHASE_INIT] = {
+        TR_NONE, TR_NONE, TR(EXTEND, HOMING_PHASE_EXTEND, NONE, KEEP), TR_NONE,
+        TR_NONE, TR_NONE, TR(EXTEND, HOMING_PHASE_EXTEND, NONE, KEEP), TR_NONE },
+    [TRANSITION_ROW_HOMING + HOMING_PHASE_EXTEND] = {
+        TR_NONE, TR(SHRINK, HOMING_PHASE_SHRINK, EXTEND, KEEP), TR_NONE, TR_NONE,
+        TR_NONE, TR(SHRINK, HOMING_PHASE_SHRINK, EXTEND, KEEP), TR_NONE, TR_NONE },
+    [TRANSITION_ROW_HOMING + HOMING_PHASE_SHRINK] = {
+        TR_NONE, TR_NONE, TR(EXTEND, HOMING_PHASE_MIDDLE, SHRINK, KEEP), TR_NONE,
+        TR_NONE, TR_NONE, TR(EXTEND, HOMING_PHASE_MIDDLE, SHRINK, KEEP), TR_NONE },
+
+    /* Park on time alone; switches are ignored */
+    [TRANSITION_ROW_HOMING + HOMING_PHASE_MIDDLE] = {
+        TR_NONE, TR_NONE, TR_NONE, TR_NONE,
+        TR(STOP, TRANSITION_PHASE_DONE, NONE, PARK), TR(STOP, TRANSITION_PHASE_DONE, NONE, PARK),
+        TR(STOP, TRANSITION_PHASE_DONE, NONE, PARK), TR(STOP, TRANSITION_PHASE_DONE, NONE, PARK) },
+};
+
+#undef TR_STOP
+#undef TR_NONE
+#undef TR
 
 /* -------------------------------------------------------------------------- */
 /*   Public API                                                               */
@@ -72,8 +451,65 @@ void actuator_init(ActuatorControl_t *p_act, const ActuatorConfig_t *p_cfg)
     p_act->is_homing                   = 0U;
     p_act->homing_phase                = HOMING_PHASE_INIT;
     p_act->homing_last_phase_end_time  = 0U;
+    p_act->homing_phase_timeout        = p_cfg->homing_timeout_ms;
+    p_act->park_time                   = 0U;
     p_act->extend_time                 = 0U;
     p_act->shrink_time                 = 0U;
+    p_act->extend_lag                  = 0U;
+    p_act->shrink_lag                  = 0U;
+    p_act->learned_extend_time         = 0U;
+    p_act->learned_shrink_time         = 0U;
+    p_act->position                    = ACTUATOR_POSITION_UNKNOWN;
+    p_act->target_position             = ACTUATOR_POSITION_UNKNOWN;
+    p_act->motion_state                = ACTUATOR_IDLE;
+    p_act->motion_start_position       = ACTUATOR_POSITION_UNKNOWN;
+    p_act->motion_start_time           = 0U;
+    p_act->target_due_time             = 0U;
+    p_act->target_count                = 0;
+    p_act->encoder_zero                = 0;
+    p_act->encoder_end                 = 0;
+    p_act->encoder_span                = 0;
+    p_act->motion_replan               = 0U;
+    p_act->output_port_count           = 0U;
+    p_act->output                      = ACTUATOR_OUTPUT_STOP;
+    p_act->speed                       = ACTUATOR_SPEED_FULL;
+    p_act->output_deferred             = 0U;
+    p_act->output_dirty                = 0U;
+    p_act->limit_latch                 = LIMIT_LATCH_NONE;
+    p_act->limit_latch_time            = 0U;
+    p_act->stall_latch                 = 0U;
+    actuator_queue_init(&p_act->commands);
+    p_act->id                          = 0U;
+    p_act->drive_start_us              = 0U;
+    p_act->extend_edge_us              = 0U;
+    p_act->shrink_edge_us              = 0U;
+    p_act->extend_edge_valid           = 0U;
+    p_act->shrink_edge_valid           = 0U;
+    p_act->extend_time_us              = 0U;
+    p_act->shrink_time_us              = 0U;
+    p_act->relay_guard                 = RELAY_GUARD_NONE;
+    p_act->relay_released              = ACTUATOR_OUTPUT_STOP;
+    p_act->relay_pending               = ACTUATOR_OUTPUT_STOP;
+    p_act->relay_release_time          = 0U;
+
+    /* ---- Precompute one BSRR word per port and output pattern ---- */
+    {
+        const uint8_t ext_on  = p_cfg->extend_active_level;
+        const uint8_t ext_off = (uint8_t)(!p_cfg->extend_active_level);
+        const uint8_t shr_on  = p_cfg->shrink_active_level;
+        const uint8_t shr_off = (uint8_t)(!p_cfg->shrink_active_level);
+
+        /*                                   STOP     EXTEND   SHRINK */
+        const uint8_t extend_levels[]     = { ext_off, ext_on,  ext_off };
+        const uint8_t shrink_levels[]     = { shr_off, shr_off, shr_on  };
+        const uint8_t led_extend_levels[] = { 0U,      1U,      0U      };
+        const uint8_t led_shrink_levels[] = { 0U,      0U,      1U      };
+
+        add_output_pin(p_act, p_cfg->extend_control_port, p_cfg->extend_control_pin, extend_levels);
+        add_output_pin(p_act, p_cfg->shrink_control_port, p_cfg->shrink_control_pin, shrink_levels);
+        add_output_pin(p_act, p_cfg->led_extend_port,     p_cfg->led_extend_pin,     led_extend_levels);
+        add_output_pin(p_act, p_cfg->led_shrink_port,     p_cfg->led_shrink_pin,     led_shrink_levels);
+    }
 
     button_debounce_init(&p_act->extend_switch,
                          p_cfg->extend_active_level,
@@ -83,258 +519,1145 @@ void actuator_init(ActuatorControl_t *p_act, const ActuatorConfig_t *p_cfg)
                          p_cfg->debounce_time_ms);
 }
 
+ACTUATOR_RAMFUNC
 void actuator_update(ActuatorControl_t *p_act, uint32_t current_time)
 {
     if (p_act == NULL) {
         return;
     }
 
+    ACTUATOR_PROFILE_START(update_start, PROFILE_UPDATE_SLOT(p_act));
+
     update_switches(p_act, current_time);
+    actuator_update_raw_debounced(p_act, current_time);
 
-    /* ---- Homing takes priority over normal operation ---- */
-    if (p_act->is_homing != 0U) {
-        handle_homing_sequence(p_act, current_time);
+    ACTUATOR_PROFILE_STOP(update_start);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_update_raw(ActuatorControl_t *p_act,
+                         uint8_t extend_level,
+                         uint8_t shrink_level,
+                         uint32_t current_time)
+{
+    if (p_act == NULL) {
         return;
     }
 
-    switch (p_act->state) {
-        case ACTUATOR_EXTENDING:
-            if (button_debounce_is_pressed(&p_act->extend_switch)) {
-                actuator_stop(p_act);
-            }
-            break;
-
-        case ACTUATOR_SHRINKING:
-            if (button_debounce_is_pressed(&p_act->shrink_switch)) {
-                actuator_stop(p_act);
-            }
-            break;
+    ACTUATOR_PROFILE_START(update_start, PROFILE_UPDATE_SLOT(p_act));
 
-        case ACTUATOR_IDLE:
-            /* Nothing to do */
-            break;
+    button_debounce_update(&p_act->extend_switch, extend_level, current_time);
+    button_debounce_update(&p_act->shrink_switch, shrink_level, current_time);
+    actuator_update_raw_debounced(p_act, current_time);
 
-        case ACTUATOR_ERROR:
-            actuator_stop(p_act);
-            break;
-    }
+    ACTUATOR_PROFILE_STOP(update_start);
 }
 
-/* -------------------------------------------------------------------------- */
-/*   Homing sequence                                                          */
-/* -------------------------------------------------------------------------- */
-
-static void handle_homing_sequence(ActuatorControl_t *p_act, uint32_t current_time)
+ACTUATOR_RAMFUNC
+void actuator_update_debounced(ActuatorControl_t *p_act,
+                               uint8_t extend_pressed,
+                               uint8_t shrink_pressed,
+                               uint8_t extend_level,
+                               uint8_t shrink_level,
+                               uint32_t current_time)
 {
     if (p_act == NULL) {
         return;
     }
 
-    /* ---- First invocation — initialise ---- */
-    if (p_act->homing_last_phase_end_time == 0U) {
-        p_act->homing_phase               = HOMING_PHASE_INIT;
-        p_act->homing_last_phase_end_time = current_time;
-        actuator_shrink(p_act);
-        return;
-    }
+    ACTUATOR_PROFILE_START(update_start, PROFILE_UPDATE_SLOT(p_act));
 
-    switch (p_act->homing_phase) {
+    button_debounce_set(&p_act->extend_switch, extend_pressed, extend_level, current_time);
+    button_debounce_set(&p_act->shrink_switch, shrink_pressed, shrink_level, current_time);
+    actuator_update_raw_debounced(p_act, current_time);
 
-        case HOMING_PHASE_INIT:
-            /* Shrink until the shrink switch is pressed */
-            if (p_act->state == ACTUATOR_SHRINKING &&
-                button_debounce_is_pressed(&p_act->shrink_switch)) {
-                p_act->homing_phase               = HOMING_PHASE_EXTEND;
-                p_act->homing_last_phase_end_time = current_time;
-                actuator_extend(p_act);
-            }
-            break;
+    ACTUATOR_PROFILE_STOP(update_start);
+}
 
-        case HOMING_PHASE_EXTEND:
-            /* Extend until the extend switch is pressed */
-            if (p_act->state == ACTUATOR_EXTENDING &&
-                button_debounce_is_pressed(&p_act->extend_switch)) {
-                p_act->extend_time  = current_time - p_act->homing_last_phase_end_time;
-                p_act->homing_phase = HOMING_PHASE_SHRINK;
-                p_act->homing_last_phase_end_time = current_time;
-                actuator_shrink(p_act);
-            }
-            break;
+ACTUATOR_RAMFUNC
+static void actuator_update_raw_debounced(ActuatorControl_t *p_act, uint32_t current_time)
+{
+    trace_switch_edges(p_act);
+    track_position(p_act, current_time);
+    if (p_act->relay_guard != RELAY_GUARD_NONE) {
+        handle_relay_guard(p_act, current_time);    /* Before planning: may start travel */
+    }
+    drain_commands(p_act);                      /* Plans from the estimate just updated */
+    sync_motion(p_act, current_time);           /* Stamp commands issued since the last update */
 
-        case HOMING_PHASE_SHRINK:
-            /* Shrink until the shrink switch is pressed */
-            if (p_act->state == ACTUATOR_SHRINKING &&
-                button_debounce_is_pressed(&p_act->shrink_switch)) {
-                p_act->shrink_time  = current_time - p_act->homing_last_phase_end_time;
-                p_act->homing_phase = HOMING_PHASE_MIDDLE;
-                p_act->homing_last_phase_end_time = current_time;
-                actuator_extend(p_act);
-            }
-            break;
+    if (p_act->limit_latch != LIMIT_LATCH_NONE) {
+        handle_limit_latch(p_act, current_time);
+    }
 
-        case HOMING_PHASE_MIDDLE:
-        {
-            /* Move half the extend time back toward centre */
-            const uint32_t move_time = p_act->extend_time / 2U;
-            if ((current_time - p_act->homing_last_phase_end_time) >= move_time) {
-                actuator_stop(p_act);
-                p_act->is_homing = 0U;
-            }
-            break;
+    if ((p_act->is_homing != 0U) && (p_act->homing_last_phase_end_time == 0U)) {
+        start_homing_sequence(p_act, current_time);
+    } else {
+        const uint8_t was_homing = p_act->is_homing;
+        const uint8_t was_stall  = p_act->stall_latch;  /* A later one waits for the next update */
+
+        if (was_homing != 0U) {
+            record_start_lag(p_act, current_time);
+        }
+        run_transition(p_act, current_time);
+        if ((was_stall != 0U) && (p_act->stall_latch != 0U)) {
+            handle_stall(p_act);                /* Not taken as an end stop */
+        }
+        if (was_homing != 0U) {
+            handle_homing_timeout(p_act, current_time);
         }
     }
 
-    /* ---- Homing safety timeout ---- */
-    if ((current_time - p_act->homing_last_phase_end_time) > HOMING_TIMEOUT_MS) {
-        actuator_stop(p_act);
-        p_act->state     = ACTUATOR_ERROR;
-        p_act->is_homing = 0U;
+    sync_motion(p_act, current_time);
+    if (p_act->config.bridge_output != NULL) {
+        update_speed(p_act);
     }
 }
 
-/* -------------------------------------------------------------------------- */
-/*   Commands                                                                 */
-/* -------------------------------------------------------------------------- */
+uint8_t actuator_post(ActuatorControl_t *p_act, const ActuatorCommand_t *p_cmd)
+{
+    if (p_act == NULL) {
+        return 0U;
+    }
+    return actuator_queue_push(&p_act->commands, p_cmd);
+}
 
-void actuator_start_homing(ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+void actuator_limit_switch_isr(ActuatorControl_t *p_act, uint16_t gpio_pin)
 {
     if (p_act == NULL) {
         return;
     }
 
-    if (p_act->state != ACTUATOR_IDLE) {
-        actuator_stop(p_act);
-    }
+    const ActuatorConfig_t *p_cfg = &p_act->config;
+    uint8_t                 hit   = 0U;
 
-    p_act->is_homing                  = 1U;
-    p_act->homing_phase               = HOMING_PHASE_INIT;
-    p_act->homing_last_phase_end_time = 0U;
-    p_act->extend_time                = 0U;
-    p_act->shrink_time                = 0U;
+    if ((p_act->state == ACTUATOR_EXTENDING) && (gpio_pin == p_cfg->extend_switch_pin)) {
+        hit = (actuator_gpio_read_pin(p_cfg->extend_switch_port, gpio_pin)
+               == p_cfg->extend_active_level) ? 1U : 0U;
+    } else if ((p_act->state == ACTUATOR_SHRINKING) && (gpio_pin == p_cfg->shrink_switch_pin)) {
+        hit = (actuator_gpio_read_pin(p_cfg->shrink_switch_port, gpio_pin)
+               == p_cfg->shrink_active_level) ? 1U : 0U;
+    }
 
-    actuator_shrink(p_act);     /* Start immediately */
+    if (hit != 0U) {
+        /* Cut the relays now, even if outputs are deferred; state is left
+           alone for the debouncer to judge */
+        cut_outputs(p_act);
+        p_act->limit_latch = LIMIT_LATCH_ISR;
+    }
 }
 
-void actuator_extend(ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+void actuator_switch_edge(ActuatorControl_t *p_act, uint16_t gpio_pin, uint32_t timestamp_us)
 {
     if (p_act == NULL) {
         return;
     }
 
-    p_act->state = ACTUATOR_EXTENDING;
-
-    set_outputs(p_act,
-                p_act->config.extend_active_level,
-                (uint8_t)(!p_act->config.shrink_active_level),
-                1U,
-                0U);
+    /* First edge only: bounce that follows must not move the timestamp */
+    if ((gpio_pin == p_act->config.extend_switch_pin) && (p_act->extend_edge_valid == 0U)) {
+        p_act->extend_edge_us    = timestamp_us;
+        p_act->extend_edge_valid = 1U;
+    } else if ((gpio_pin == p_act->config.shrink_switch_pin) && (p_act->shrink_edge_valid == 0U)) {
+        p_act->shrink_edge_us    = timestamp_us;
+        p_act->shrink_edge_valid = 1U;
+    }
 }
 
-void actuator_shrink(ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+void actuator_stall_isr(ActuatorControl_t *p_act)
 {
     if (p_act == NULL) {
         return;
     }
 
-    p_act->state = ACTUATOR_SHRINKING;
+    if ((p_act->state == ACTUATOR_EXTENDING) || (p_act->state == ACTUATOR_SHRINKING)) {
+        /* Cut the relays now, even if outputs are deferred */
+        cut_outputs(p_act);
+        p_act->stall_latch = 1U;
+    }
+}
+
+ACTUATOR_RAMFUNC
+static void handle_limit_latch(ActuatorControl_t *p_act, uint32_t current_time)
+{
+    const ButtonDebounce_t *p_sw;
+    ActuatorOutput_t        resume;
+
+    if (p_act->state == ACTUATOR_EXTENDING) {
+        p_sw   = &p_act->extend_switch;
+        resume = ACTUATOR_OUTPUT_EXTEND;
+    } else if (p_act->state == ACTUATOR_SHRINKING) {
+        p_sw   = &p_act->shrink_switch;
+        resume = ACTUATOR_OUTPUT_SHRINK;
+    } else {
+        p_act->limit_latch = LIMIT_LATCH_NONE;
+        return;
+    }
+
+    if (p_act->limit_latch == LIMIT_LATCH_ISR) {
+        p_act->limit_latch      = LIMIT_LATCH_ARMED;
+        p_act->limit_latch_time = current_time;
+    }
 
-    set_outputs(p_act,
-                (uint8_t)(!p_act->config.extend_active_level),
-                p_act->config.shrink_active_level,
-                0U,
-                1U);
+    if (button_debounce_is_pressed(p_sw)) {
+        /* Confirmed — the regular switch handling below completes the stop */
+        p_act->limit_latch = LIMIT_LATCH_NONE;
+    } else if ((p_sw->last_raw_state != p_sw->active_state) &&
+               ((current_time - p_act->limit_latch_time) >= p_sw->debounce_delay) &&
+               ((current_time - p_sw->last_time) >= p_sw->debounce_delay)) {
+        /* Switch has read open for a full window — it was a glitch */
+        p_act->limit_latch = LIMIT_LATCH_NONE;
+        set_outputs(p_act, resume);
+    } else {
+        /* Still undecided — keep the relays released */
+        set_outputs(p_act, ACTUATOR_OUTPUT_STOP);
+    }
 }
 
-void actuator_stop(ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+static void handle_relay_guard(ActuatorControl_t *p_act, uint32_t current_time)
 {
-    if (p_act == NULL) {
+    if (p_act->relay_guard == RELAY_GUARD_RELEASED) {
+        p_act->relay_guard        = RELAY_GUARD_ARMED;
+        p_act->relay_release_time = current_time;
+    }
+
+    if ((current_time - p_act->relay_release_time) < p_act->config.relay_dead_time_ms) {
         return;
     }
 
-    p_act->state = ACTUATOR_IDLE;
+    p_act->relay_guard = RELAY_GUARD_NONE;
+
+    if (p_act->relay_pending != ACTUATOR_OUTPUT_STOP) {
+        set_outputs(p_act, p_act->relay_pending);
 
-    set_outputs(p_act,
-                (uint8_t)(!p_act->config.extend_active_level),
-                (uint8_t)(!p_act->config.shrink_active_level),
-                0U,
-                0U);
+        /* The motor starts only now: time the travel and the move from here */
+        if (p_act->config.timestamp_us != NULL) {
+            stamp_drive_start(p_act);
+        }
+        if (p_act->is_homing != 0U) {
+            p_act->homing_last_phase_end_time = current_time;
+        }
+        p_act->motion_state = ACTUATOR_IDLE;    /* The motor starts from rest now */
+    }
 }
 
 /* -------------------------------------------------------------------------- */
-/*   Queries                                                                  */
+/*   Homing sequence                                                          */
 /* -------------------------------------------------------------------------- */
 
-ActuatorState_t actuator_get_state(const ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+static void start_homing_sequence(ActuatorControl_t *p_act, uint32_t current_time)
 {
-    if (p_act == NULL) {
-        return ACTUATOR_IDLE;
-    }
-    return p_act->state;
+    p_act->homing_phase               = HOMING_PHASE_INIT;
+    p_act->homing_last_phase_end_time = current_time;
+    p_act->homing_phase_timeout       = homing_phase_timeout(p_act, HOMING_PHASE_INIT);
+    ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_PHASE, HOMING_PHASE_INIT);
+    actuator_shrink(p_act);
 }
 
-uint8_t actuator_is_homing(const ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+static void handle_stall(ActuatorControl_t *p_act)
 {
-    if (p_act == NULL) {
-        return 0U;
-    }
-    return p_act->is_homing;
+    ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_STALL, p_act->state);
+    actuator_stop(p_act);
+    ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_STATE,
+                   (uint32_t)ACTUATOR_ERROR | ((uint32_t)p_act->state << 8U));
+    p_act->state     = ACTUATOR_ERROR;
+    p_act->is_homing = 0U;
 }
 
-uint8_t actuator_is_error(const ActuatorControl_t *p_act)
+ACTUATOR_RAMFUNC
+static void handle_homing_timeout(ActuatorControl_t *p_act, uint32_t current_time)
 {
-    if (p_act == NULL) {
-        return 0U;
+    if ((current_time - p_act->homing_last_phase_end_time) > p_act->homing_phase_timeout) {
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_TIMEOUT, p_act->homing_phase);
+        actuator_stop(p_act);
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_STATE,
+                       (uint32_t)ACTUATOR_ERROR | ((uint32_t)p_act->state << 8U));
+        p_act->state     = ACTUATOR_ERROR;
+        p_act->is_homing = 0U;
     }
-    return (p_act->state == ACTUATOR_ERROR) ? 1U : 0U;
 }
 
-/* -------------------------------------------------------------------------- */
-/*   Private helpers                                                          */
-/* -------------------------------------------------------------------------- */
-
-static void set_outputs(const ActuatorControl_t *p_act,
-                        uint8_t extend_active,
-                        uint8_t shrink_active,
-                        uint8_t led_extend,
-                        uint8_t led_shrink)
+ACTUATOR_RAMFUNC
+static uint32_t homing_phase_timeout(const ActuatorControl_t *p_act, HomingPhase_t phase)
 {
-    if (p_act == NULL) {
-        return;
-    }
+    const uint32_t fixed   = p_act->config.homing_timeout_ms;
+    const uint32_t margin  = p_act->config.homing_margin_pct;
 
-    /* Cast void* back to the HAL type at the last responsible moment */
-    HAL_GPIO_WritePin((GPIO_TypeDef*)p_act->config.extend_control_port,
-                      p_act->config.extend_control_pin,
-                      (GPIO_PinState)extend_active);
+    /* INIT and SHRINK end on the shrink switch; MIDDLE is at most an extend */
+    const uint32_t learned = ((phase == HOMING_PHASE_EXTEND) || (phase == HOMING_PHASE_MIDDLE))
+                             ? p_act->learned_extend_time
+                             : p_act->learned_shrink_time;
 
-    HAL_GPIO_WritePin((GPIO_TypeDef*)p_act->config.shrink_control_port,
-                      p_act->config.shrink_control_pin,
-                      (GPIO_PinState)shrink_active);
-
-    HAL_GPIO_WritePin((GPIO_TypeDef*)p_act->config.led_extend_port,
-                      p_act->config.led_extend_pin,
-                      (GPIO_PinState)led_extend);
+    if ((margin == 0U) || (learned == 0U)) {
+        return fixed;
+    }
 
-    HAL_GPIO_WritePin((GPIO_TypeDef*)p_act->config.led_shrink_port,
-                      p_act->config.led_shrink_pin,
-                      (GPIO_PinState)led_shrink);
+    const uint64_t adaptive = ((uint64_t)learned * (100U + margin)) / 100U;
+    return (adaptive < (uint64_t)fixed) ? (uint32_t)adaptive : fixed;
 }
 
-static void update_switches(ActuatorControl_t *p_act, uint32_t current_time)
+ACTUATOR_RAMFUNC
+static void record_start_lag(ActuatorControl_t *p_act, uint32_t current_time)
 {
-    if (p_act == NULL) {
-        return;
+    /* Both phases start at an end stop; the motor is moving once it lets go,
+       though not yet at full speed behind an acceleration ramp */
+    const uint32_t lag = current_time - p_act->homing_last_phase_end_time + p_act->config.start_lag_ms;
+
+    if ((p_act->homing_phase == HOMING_PHASE_EXTEND) && (p_act->shrink_switch.just_released != 0U)) {
+        p_act->extend_lag = lag;
+    } else if ((p_act->homing_phase == HOMING_PHASE_SHRINK) && (p_act->extend_switch.just_released != 0U)) {
+        p_act->shrink_lag = lag;
     }
+}
 
-    button_debounce_update(&p_act->extend_switch,
-                           (uint8_t)HAL_GPIO_ReadPin(
-                               (GPIO_TypeDef*)p_act->config.extend_switch_port,
-                               p_act->config.extend_switch_pin),
+ACTUATOR_RAMFUNC
+static uint32_t drive_time(const ActuatorControl_t *p_act, uint32_t travel, uint32_t lag,
+                           uint8_t in_us, uint32_t permille)
+{
+    const uint32_t unit     = (in_us != 0U) ? ACTUATOR_US_PER_TICK : 1U;
+    const uint32_t debounce = p_act->config.debounce_time_ms;
+
+    /* µs travel runs to the first edge, not to a debounced press */
+    const uint32_t start = (lag > debounce) ? ((lag - debounce) * unit) : 0U;
+    const uint32_t lead  = (in_us != 0U) ? start : lag;
+
+    if ((lag == 0U) || (lead >= travel)) {
+        return (uint32_t)((((uint64_t)travel * permille) + (ACTUATOR_POSITION_MAX - 1U))
+                          / ACTUATOR_POSITION_MAX);
+    }
+
+    /* Round up so the stop never lands short of the target */
+    const uint32_t run  = start + (uint32_t)((((uint64_t)(travel - lead) * permille) +
+                                              (ACTUATOR_POSITION_MAX - 1U)) / ACTUATOR_POSITION_MAX);
+    const uint32_t stop = p_act->config.stop_lag_ms * unit;
+
+    return (run > stop) ? (run - stop) : 0U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Transition table                                                         */
+/* -------------------------------------------------------------------------- */
+
+ACTUATOR_RAMFUNC
+static void run_transition(ActuatorControl_t *p_act, uint32_t current_time)
+{
+    const uint32_t row = (p_act->is_homing != 0U)
+                         ? (TRANSITION_ROW_HOMING + (uint32_t)p_act->homing_phase)
+                         : (uint32_t)p_act->state;
+
+    /* Only the switch ahead of the current direction of travel counts */
+    uint32_t inputs = ((uint32_t)button_debounce_is_pressed(&p_act->extend_switch) << 0U) |
+                      ((uint32_t)button_debounce_is_pressed(&p_act->shrink_switch) << 1U);
+    inputs &= s_switch_ahead[p_act->state];
+
+    if ((p_act->stall_latch != 0U) && (p_act->config.stall_end_stop != 0U)) {
+        inputs |= s_switch_ahead[p_act->state];   /* Sensorless: the stall is the end stop */
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_STALL, (uint32_t)p_act->state | (1U << 8U));
+    }
+
+    if (((row == (TRANSITION_ROW_HOMING + (uint32_t)HOMING_PHASE_MIDDLE)) ||
+         (p_act->target_position != ACTUATOR_POSITION_UNKNOWN)) && (encoder_ready(p_act) != 0U)) {
+        /* Closed loop: the park or move ends on the count, not on time */
+        if (encoder_delay(p_act) == 0U) {
+            inputs |= TRANSITION_IN_TIMER;
+        }
+    } else if (row == (TRANSITION_ROW_HOMING + (uint32_t)HOMING_PHASE_MIDDLE)) {
+        /* Extend from the shrink stop for the precomputed park time */
+        if (p_act->extend_time_us != 0U) {
+            if ((p_act->config.timestamp_us() - p_act->drive_start_us) >= p_act->park_time) {
+                inputs |= TRANSITION_IN_TIMER;
+            }
+        } else if ((current_time - p_act->homing_last_phase_end_time) >= p_act->park_time) {
+            inputs |= TRANSITION_IN_TIMER;
+        }
+    } else if ((p_act->target_position != ACTUATOR_POSITION_UNKNOWN) &&
+               ((int32_t)(current_time - p_act->target_due_time) >= 0)) {
+        inputs |= TRANSITION_IN_TIMER;
+    }
+
+    const ActuatorTransition_t *p_tr = &s_transitions[row][inputs];
+    if ((p_tr->drive == TRANSITION_DRIVE_KEEP) && (p_tr->phase == TRANSITION_PHASE_KEEP)) {
+        return;                                 /* Common case: nothing changes */
+    }
+
+    /* Resolve before driving: actuator_stop() clears the target */
+    const uint16_t position = (p_tr->position == TRANSITION_POS_TARGET) ? p_act->target_position
+                            : (p_tr->position == TRANSITION_POS_PARK)   ? p_act->config.park_position
+                            :                                             s_positions[p_tr->position];
+
+    if (p_tr->measure == TRANSITION_MEASURE_EXTEND) {
+        p_act->extend_time = travel_time(p_act, p_act->extend_edge_valid, p_act->extend_edge_us,
+                                         &p_act->extend_time_us, current_time);
+    } else if (p_tr->measure == TRANSITION_MEASURE_SHRINK) {
+        p_act->shrink_time = travel_time(p_act, p_act->shrink_edge_valid, p_act->shrink_edge_us,
+                                         &p_act->shrink_time_us, current_time);
+    }
+    if (p_act->config.encoder_count != NULL) {
+        encoder_reference(p_act, p_tr->measure, p_tr->position);
+    }
+
+    if (p_tr->phase == TRANSITION_PHASE_DONE) {
+        p_act->is_homing           = 0U;
+        p_act->learned_extend_time = p_act->extend_time;
+        p_act->learned_shrink_time = p_act->shrink_time;
+    } else if (p_tr->phase != TRANSITION_PHASE_KEEP) {
+        p_act->homing_phase               = (HomingPhase_t)p_tr->phase;
+        p_act->homing_last_phase_end_time = current_time;
+        p_act->homing_phase_timeout       = homing_phase_timeout(p_act, p_act->homing_phase);
+        if (p_act->homing_phase == HOMING_PHASE_MIDDLE) {
+            p_act->park_time = (p_act->extend_time_us != 0U)
+                ? drive_time(p_act, p_act->extend_time_us, p_act->extend_lag, 1U, p_act->config.park_position)
+                : drive_time(p_act, p_act->extend_time, p_act->extend_lag, 0U, p_act->config.park_position);
+            if (encoder_ready(p_act) != 0U) {
+                p_act->target_count = encoder_target(p_act, p_act->config.park_position, ACTUATOR_EXTENDING);
+            }
+        }
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_PHASE, p_tr->phase);
+    }
+
+    if (p_tr->drive != TRANSITION_DRIVE_KEEP) {
+        s_drive[p_tr->drive](p_act);
+    }
+
+    if (p_tr->position != TRANSITION_POS_KEEP) {
+        p_act->position = position;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Commands                                                                 */
+/* -------------------------------------------------------------------------- */
+
+ACTUATOR_RAMFUNC
+void actuator_start_homing(ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return;
+    }
+
+    if (p_act->state != ACTUATOR_IDLE) {
+        actuator_stop(p_act);
+    }
+
+    p_act->is_homing                  = 1U;
+    p_act->homing_phase               = HOMING_PHASE_INIT;
+    p_act->homing_last_phase_end_time = 0U;
+    p_act->extend_time                = 0U;
+    p_act->shrink_time                = 0U;
+    p_act->extend_time_us             = 0U;
+    p_act->shrink_time_us             = 0U;
+    p_act->extend_lag                 = 0U;
+    p_act->shrink_lag                 = 0U;
+    p_act->encoder_span               = 0;
+    p_act->position                   = ACTUATOR_POSITION_UNKNOWN;
+
+    actuator_shrink(p_act);     /* Start immediately */
+}
+
+void actuator_restore_calibration(ActuatorControl_t *p_act,
+                                  uint32_t extend_time,
+                                  uint32_t shrink_time,
+                                  uint16_t position)
+{
+    if ((p_act == NULL) || (p_act->is_homing != 0U) || (p_act->state != ACTUATOR_IDLE)) {
+        return;
+    }
+    if ((extend_time == 0U) || (shrink_time == 0U) || (position > ACTUATOR_POSITION_MAX)) {
+        return;
+    }
+
+    p_act->extend_time         = extend_time;
+    p_act->shrink_time         = shrink_time;
+    p_act->learned_extend_time = extend_time;
+    p_act->learned_shrink_time = shrink_time;
+    p_act->extend_time_us      = 0U;
+    p_act->shrink_time_us      = 0U;
+    p_act->extend_lag          = 0U;        /* Not stored: moves use the plain travel share */
+    p_act->shrink_lag          = 0U;
+    p_act->encoder_span        = 0;         /* Counts restart at boot: closed loop after homing */
+    p_act->position            = position;
+}
+
+ACTUATOR_RAMFUNC
+void actuator_extend(ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return;
+    }
+
+    p_act->target_position = ACTUATOR_POSITION_UNKNOWN;
+    drive(p_act, ACTUATOR_EXTENDING, ACTUATOR_OUTPUT_EXTEND);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_shrink(ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return;
+    }
+
+    p_act->target_position = ACTUATOR_POSITION_UNKNOWN;
+    drive(p_act, ACTUATOR_SHRINKING, ACTUATOR_OUTPUT_SHRINK);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_stop(ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return;
+    }
+
+    p_act->target_position = ACTUATOR_POSITION_UNKNOWN;
+    drive(p_act, ACTUATOR_IDLE, ACTUATOR_OUTPUT_STOP);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_move_to(ActuatorControl_t *p_act, uint16_t permille)
+{
+    if ((p_act == NULL) || (permille > ACTUATOR_POSITION_MAX)) {
+        return;
+    }
+    if ((actuator_is_calibrated(p_act) == 0U) || (p_act->state == ACTUATOR_ERROR) ||
+        (p_act->position == ACTUATOR_POSITION_UNKNOWN)) {
+        return;
+    }
+
+    /* End positions are reached through the limit switches */
+    if (permille == ACTUATOR_POSITION_MAX) {
+        actuator_extend(p_act);
+        return;
+    }
+    if (permille == 0U) {
+        actuator_shrink(p_act);
+        return;
+    }
+
+    if (permille > p_act->position) {
+        p_act->target_position = permille;
+        drive(p_act, ACTUATOR_EXTENDING, ACTUATOR_OUTPUT_EXTEND);
+    } else if (permille < p_act->position) {
+        p_act->target_position = permille;
+        drive(p_act, ACTUATOR_SHRINKING, ACTUATOR_OUTPUT_SHRINK);
+    } else {
+        actuator_stop(p_act);
+    }
+
+    /* Re-plan from the current estimate even if the direction is unchanged */
+    p_act->motion_replan = 1U;
+}
+
+void actuator_defer_outputs(ActuatorControl_t *p_act, uint8_t deferred)
+{
+    if (p_act == NULL) {
+        return;
+    }
+
+    p_act->output_deferred = (deferred != 0U) ? 1U : 0U;
+    p_act->output_dirty    = 0U;
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_take_output(ActuatorControl_t *p_act, ActuatorOutput_t *p_output)
+{
+    if ((p_act == NULL) || (p_output == NULL) || (p_act->output_dirty == 0U)) {
+        return 0U;
+    }
+
+    p_act->output_dirty = 0U;
+
+    /* A pending EXTI or stall stop overrides whatever the last update selected */
+    *p_output = (actuator_output_cut(p_act) != 0U) ? ACTUATOR_OUTPUT_STOP : p_act->output;
+    return 1U;
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_output_cut(const ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return 0U;
+    }
+    return ((p_act->limit_latch != LIMIT_LATCH_NONE) || (p_act->stall_latch != 0U)) ? 1U : 0U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Queries                                                                  */
+/* -------------------------------------------------------------------------- */
+
+ActuatorState_t actuator_get_state(const ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return ACTUATOR_IDLE;
+    }
+    return p_act->state;
+}
+
+uint8_t actuator_is_homing(const ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return 0U;
+    }
+    return p_act->is_homing;
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_is_calibrated(const ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return 0U;
+    }
+    return ((p_act->is_homing == 0U) &&
+            (p_act->extend_time != 0U) &&
+            (p_act->shrink_time != 0U)) ? 1U : 0U;
+}
+
+uint16_t actuator_get_position(const ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return ACTUATOR_POSITION_UNKNOWN;
+    }
+    return p_act->position;
+}
+
+int32_t actuator_get_position_counts(const ActuatorControl_t *p_act)
+{
+    if ((p_act == NULL) || (encoder_ready(p_act) == 0U)) {
+        return ACTUATOR_COUNTS_UNKNOWN;
+    }
+    return p_act->config.encoder_count() - p_act->encoder_zero;
+}
+
+uint8_t actuator_is_error(const ActuatorControl_t *p_act)
+{
+    if (p_act == NULL) {
+        return 0U;
+    }
+    return (p_act->state == ACTUATOR_ERROR) ? 1U : 0U;
+}
+
+uint32_t actuator_next_deadline(const ActuatorControl_t *p_act, uint32_t current_time)
+{
+    if (p_act == NULL) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+
+    uint32_t delay = ACTUATOR_NO_DEADLINE;
+
+    if (actuator_queue_pending(&p_act->commands) != 0U) {
+        return 0U;
+    }
+
+    /* ---- Switch levels that still have to settle ---- */
+    if (p_act->extend_switch.last_raw_state != p_act->extend_switch.stable_state) {
+        delay = deadline_min(delay,
+                             p_act->extend_switch.last_time + p_act->extend_switch.debounce_delay,
+                             current_time);
+    }
+    if (p_act->shrink_switch.last_raw_state != p_act->shrink_switch.stable_state) {
+        delay = deadline_min(delay,
+                             p_act->shrink_switch.last_time + p_act->shrink_switch.debounce_delay,
+                             current_time);
+    }
+
+    /* ---- EXTI or stall stop awaiting its verdict ---- */
+    if ((p_act->limit_latch == LIMIT_LATCH_ISR) || (p_act->stall_latch != 0U)) {
+        return 0U;
+    }
+    if (p_act->limit_latch == LIMIT_LATCH_ARMED) {
+        const ButtonDebounce_t *p_sw = (p_act->state == ACTUATOR_SHRINKING)
+                                       ? &p_act->shrink_switch : &p_act->extend_switch;
+        uint32_t due = p_act->limit_latch_time + p_act->config.debounce_time_ms;
+
+        /* The glitch verdict also waits for a full open window */
+        if ((int32_t)((p_sw->last_time + p_sw->debounce_delay) - due) > 0) {
+            due = p_sw->last_time + p_sw->debounce_delay;
+        }
+        delay = deadline_min(delay, due, current_time);
+    }
+
+    /* ---- Direction held back for the relay dead time ---- */
+    if (p_act->relay_pending != ACTUATOR_OUTPUT_STOP) {
+        if (p_act->relay_guard == RELAY_GUARD_RELEASED) {
+            return 0U;
+        }
+        delay = deadline_min(delay,
+                             p_act->relay_release_time + p_act->config.relay_dead_time_ms,
+                             current_time);
+    }
+
+    /* ---- State-dependent work ---- */
+    if ((p_act->state == ACTUATOR_ERROR) ||
+        (p_act->state != p_act->motion_state) || (p_act->motion_replan != 0U)) {
+        return 0U;                              /* Error to latch, or segment to stamp */
+    }
+    if ((p_act->target_position != ACTUATOR_POSITION_UNKNOWN) &&
+        ((p_act->state == ACTUATOR_EXTENDING) || (p_act->state == ACTUATOR_SHRINKING))) {
+        if (encoder_ready(p_act) != 0U) {
+            const uint32_t left = encoder_delay(p_act);
+            delay = (left < delay) ? left : delay;
+        } else {
+            delay = deadline_min(delay, p_act->target_due_time, current_time);
+        }
+    }
+    if ((p_act->config.bridge_output != NULL) && (p_act->speed == ACTUATOR_SPEED_FULL)) {
+        const uint32_t left = approach_delay(p_act);
+        delay = (left < delay) ? left : delay;
+    }
+    if ((p_act->config.switch_edge_wakeup == 0U) &&
+        ((p_act->state == ACTUATOR_EXTENDING) || (p_act->state == ACTUATOR_SHRINKING))) {
+        delay = (delay < 1U) ? delay : 1U;      /* Switches must be polled */
+    }
+
+    if (p_act->is_homing != 0U) {
+        const uint32_t phase_start = p_act->homing_last_phase_end_time;
+
+        if (phase_start == 0U) {
+            return 0U;                          /* First homing invocation */
+        }
+        if ((p_act->homing_phase == HOMING_PHASE_MIDDLE) && (encoder_ready(p_act) != 0U)) {
+            const uint32_t left = encoder_delay(p_act);
+            delay = (left < delay) ? left : delay;
+        } else if (p_act->homing_phase == HOMING_PHASE_MIDDLE) {
+            /* Edge-timed: the last sub-tick part is polled (deadline 0) */
+            const uint32_t park = (p_act->extend_time_us != 0U)
+                                  ? (p_act->park_time / ACTUATOR_US_PER_TICK)
+                                  : p_act->park_time;
+            delay = deadline_min(delay, phase_start + park, current_time);
+        }
+        delay = deadline_min(delay, phase_start + p_act->homing_phase_timeout + 1U, current_time);
+    }
+
+    return delay;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t deadline_min(uint32_t delay, uint32_t due, uint32_t current_time)
+{
+    const uint32_t remaining = due - current_time;
+
+    if ((int32_t)remaining <= 0) {
+        return 0U;
+    }
+    return (remaining < delay) ? remaining : delay;
+}
+
+ACTUATOR_RAMFUNC
+static void drive(ActuatorControl_t *p_act, ActuatorState_t state, ActuatorOutput_t output)
+{
+    if (state != p_act->state) {
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_STATE, (uint32_t)state | ((uint32_t)p_act->state << 8U));
+    }
+
+    if ((state != p_act->state) && (p_act->config.timestamp_us != NULL)) {
+        stamp_drive_start(p_act);
+    }
+
+    p_act->limit_latch = LIMIT_LATCH_NONE;      /* Cleared before state so a racing ISR re-latches */
+    p_act->stall_latch = 0U;
+    p_act->state       = state;
+
+    set_outputs(p_act, output);
+}
+
+ACTUATOR_RAMFUNC
+static void stamp_drive_start(ActuatorControl_t *p_act)
+{
+    /* Flags first: an edge racing in between is older than the stamp and rejected */
+    p_act->extend_edge_valid = 0U;
+    p_act->shrink_edge_valid = 0U;
+    p_act->drive_start_us    = p_act->config.timestamp_us();
+}
+
+ACTUATOR_RAMFUNC
+static void drain_commands(ActuatorControl_t *p_act)
+{
+    ActuatorCommand_t command;
+
+    /* Bounded: the producer can add at most ACTUATOR_QUEUE_SIZE while we run */
+    for (uint8_t i = 0U; i < (uint8_t)(2U * ACTUATOR_QUEUE_SIZE); i++) {
+        if (actuator_queue_pop(&p_act->commands, &command) == 0U) {
+            break;
+        }
+        ACTUATOR_TRACE(p_act, (uint32_t)ACTUATOR_TRACE_COMMAND + (uint32_t)command.type, command.argument);
+        actuator_command_apply(p_act, &command);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static uint32_t travel_time(const ActuatorControl_t *p_act,
+                            uint8_t edge_valid,
+                            uint32_t edge_us,
+                            uint32_t *p_time_us,
+                            uint32_t current_time)
+{
+    const uint32_t ticks = current_time - p_act->homing_last_phase_end_time;
+
+    *p_time_us = 0U;
+    if ((p_act->config.timestamp_us == NULL) || (edge_valid == 0U)) {
+        return ticks;
+    }
+
+    /* The edge must precede the debounced press by no more than bounce and
+       debounce can explain; an earlier one was a glitch mid-travel */
+    const uint32_t us     = edge_us - p_act->drive_start_us;
+    const uint32_t window = ((2U * p_act->config.debounce_time_ms) + 2U) * ACTUATOR_US_PER_TICK;
+    const uint32_t max_us = ticks * ACTUATOR_US_PER_TICK;
+
+    if (((int32_t)us <= 0) || (us > max_us) || ((max_us - us) > window)) {
+        return ticks;
+    }
+
+    const uint32_t rounded = (us + (ACTUATOR_US_PER_TICK / 2U)) / ACTUATOR_US_PER_TICK;
+
+    *p_time_us = us;
+    return (rounded != 0U) ? rounded : 1U;
+}
+
+ACTUATOR_RAMFUNC
+static void trace_switch_edges(const ActuatorControl_t *p_act)
+{
+    if ((p_act->extend_switch.just_pressed != 0U) || (p_act->extend_switch.just_released != 0U)) {
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_SWITCH, 0U | ((uint32_t)p_act->extend_switch.just_pressed << 8U));
+    }
+    if ((p_act->shrink_switch.just_pressed != 0U) || (p_act->shrink_switch.just_released != 0U)) {
+        ACTUATOR_TRACE(p_act, ACTUATOR_TRACE_SWITCH, 1U | ((uint32_t)p_act->shrink_switch.just_pressed << 8U));
+    }
+}
+
+ACTUATOR_RAMFUNC
+static uint8_t encoder_ready(const ActuatorControl_t *p_act)
+{
+    return ((p_act->config.encoder_count != NULL) && (p_act->encoder_span > 0)) ? 1U : 0U;
+}
+
+ACTUATOR_RAMFUNC
+static int32_t encoder_target(const ActuatorControl_t *p_act, uint16_t permille, ActuatorState_t state)
+{
+    const int64_t  span   = p_act->encoder_span;
+    const uint32_t travel = (state == ACTUATOR_EXTENDING) ? p_act->extend_time : p_act->shrink_time;
+    const int32_t  aim    = p_act->encoder_zero +
+                            (int32_t)(((span * permille) + (ACTUATOR_POSITION_MAX / 2U)) / ACTUATOR_POSITION_MAX);
+    const int32_t  lead   = (travel != 0U)
+                            ? (int32_t)((span * p_act->config.stop_lag_ms) / travel)
+                            : 0;
+
+    return (state == ACTUATOR_EXTENDING) ? (aim - lead) : (aim + lead);
+}
+
+ACTUATOR_RAMFUNC
+static uint32_t encoder_delay(const ActuatorControl_t *p_act)
+{
+    const int32_t  count  = p_act->config.encoder_count();
+    const uint8_t  extend = (p_act->state == ACTUATOR_EXTENDING) ? 1U : 0U;
+    const int32_t  left   = (extend != 0U) ? (p_act->target_count - count) : (count - p_act->target_count);
+    const uint32_t travel = (extend != 0U) ? p_act->extend_time : p_act->shrink_time;
+
+    if (left <= 0) {
+        return 0U;
+    }
+
+    const uint64_t ticks = ((uint64_t)left * travel) / (2U * (uint64_t)p_act->encoder_span);
+    return (ticks == 0U) ? 1U : (ticks > 0xFFFFFFFEU) ? 0xFFFFFFFEU : (uint32_t)ticks;
+}
+
+ACTUATOR_RAMFUNC
+static void encoder_reference(ActuatorControl_t *p_act, uint8_t measure, uint8_t position)
+{
+    const int32_t count = p_act->config.encoder_count();
+
+    if (measure == TRANSITION_MEASURE_EXTEND) {
+        p_act->encoder_end = count;
+    } else if (measure == TRANSITION_MEASURE_SHRINK) {
+        /* A stroke that did not count up: encoder missing or wired backwards */
+        p_act->encoder_zero = count;
+        p_act->encoder_span = (p_act->encoder_end > count) ? (p_act->encoder_end - count) : 0;
+    } else if (p_act->encoder_span != 0) {
+        /* Missed or spurious counts do not accumulate past an end stop */
+        if (position == TRANSITION_POS_ZERO) {
+            p_act->encoder_zero = count;
+        } else if (position == TRANSITION_POS_MAX) {
+            p_act->encoder_zero = count - p_act->encoder_span;
+        }
+    }
+}
+
+ACTUATOR_RAMFUNC
+static void track_position(ActuatorControl_t *p_act, uint32_t current_time)
+{
+    uint32_t travel_time;
+
+    if (encoder_ready(p_act) != 0U) {
+        /* Measured, at rest too: includes the run-down after a stop */
+        const int32_t counts = p_act->config.encoder_count() - p_act->encoder_zero;
+        const int64_t pos    = (((int64_t)counts * ACTUATOR_POSITION_MAX) + (p_act->encoder_span / 2)) /
+                               p_act->encoder_span;
+
+        p_act->position = (pos <= 0) ? 0U
+                        : (pos >= (int64_t)ACTUATOR_POSITION_MAX) ? (uint16_t)ACTUATOR_POSITION_MAX
+                        : (uint16_t)pos;
+        return;
+    }
+
+    if (p_act->motion_state == ACTUATOR_EXTENDING) {
+        travel_time = p_act->extend_time;
+    } else if (p_act->motion_state == ACTUATOR_SHRINKING) {
+        travel_time = p_act->shrink_time;
+    } else {
+        return;                                 /* At rest — position is final */
+    }
+    if (p_act->relay_pending != ACTUATOR_OUTPUT_STOP) {
+        return;                                 /* Held for the relay dead time */
+    }
+
+    const uint16_t start = p_act->motion_start_position;
+    if ((start == ACTUATOR_POSITION_UNKNOWN) || (travel_time == 0U)) {
+        p_act->position = ACTUATOR_POSITION_UNKNOWN;
+        return;
+    }
+
+    /* Travel times are bounded by the homing timeout, so the product fits */
+    const uint32_t elapsed = current_time - p_act->motion_start_time;
+    const uint32_t moved   = (elapsed >= travel_time)
+                             ? ACTUATOR_POSITION_MAX
+                             : ((elapsed * ACTUATOR_POSITION_MAX) / travel_time);
+
+    if (p_act->motion_state == ACTUATOR_EXTENDING) {
+        const uint32_t pos = (uint32_t)start + moved;
+        p_act->position = (uint16_t)((pos > ACTUATOR_POSITION_MAX) ? ACTUATOR_POSITION_MAX : pos);
+    } else {
+        p_act->position = (uint16_t)((start > moved) ? (start - moved) : 0U);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static void sync_motion(ActuatorControl_t *p_act, uint32_t current_time)
+{
+    if ((p_act->state == p_act->motion_state) && (p_act->motion_replan == 0U)) {
+        return;
+    }
+
+    /* A re-plan in the same direction continues a running motor */
+    const uint8_t from_rest = (p_act->state != p_act->motion_state) ? 1U : 0U;
+
+    p_act->motion_replan         = 0U;
+    p_act->motion_state          = p_act->state;
+    p_act->motion_start_position = p_act->position;
+    p_act->motion_start_time     = current_time;
+
+    if ((p_act->target_position == ACTUATOR_POSITION_UNKNOWN) ||
+        (p_act->position == ACTUATOR_POSITION_UNKNOWN)) {
+        return;
+    }
+
+    uint32_t distance;
+    uint32_t travel_time;
+    uint32_t lag;
+
+    if (p_act->state == ACTUATOR_EXTENDING) {
+        distance    = (uint32_t)p_act->target_position - p_act->position;
+        travel_time = p_act->extend_time;
+        lag         = p_act->extend_lag;
+    } else if (p_act->state == ACTUATOR_SHRINKING) {
+        distance    = (uint32_t)p_act->position - p_act->target_position;
+        travel_time = p_act->shrink_time;
+        lag         = p_act->shrink_lag;
+    } else {
+        return;
+    }
+
+    p_act->target_due_time = current_time +
+        drive_time(p_act, travel_time, (from_rest != 0U) ? lag : 0U, 0U, distance);
+    if (encoder_ready(p_act) != 0U) {
+        p_act->target_count = encoder_target(p_act, p_act->target_position, p_act->state);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static ActuatorOutput_t interlock_outputs(ActuatorControl_t *p_act, ActuatorOutput_t output)
+{
+    const ActuatorOutput_t current = p_act->output;
+
+    p_act->relay_pending = ACTUATOR_OUTPUT_STOP;
+
+    if ((current != ACTUATOR_OUTPUT_STOP) && (current != output)) {
+        /* A relay drops out now; its dead time is stamped at the next update */
+        p_act->relay_released = current;
+        p_act->relay_guard    = RELAY_GUARD_RELEASED;
+    }
+
+    if ((output != ACTUATOR_OUTPUT_STOP) && (p_act->relay_guard != RELAY_GUARD_NONE) &&
+        (output != p_act->relay_released)) {
+        p_act->relay_pending = output;
+        return ACTUATOR_OUTPUT_STOP;
+    }
+    return output;
+}
+
+ACTUATOR_RAMFUNC
+static void set_outputs(ActuatorControl_t *p_act, ActuatorOutput_t output)
+{
+    if (p_act->config.relay_dead_time_ms != 0U) {
+        output = interlock_outputs(p_act, output);
+    }
+
+    if (p_act->config.bridge_output != NULL) {
+        const ButtonDebounce_t *p_ahead = (p_act->output == ACTUATOR_OUTPUT_EXTEND) ? &p_act->extend_switch
+                                        : (p_act->output == ACTUATOR_OUTPUT_SHRINK) ? &p_act->shrink_switch
+                                        : NULL;
+
+        /* Arrived on the end stop: there is no travel left to ramp down in */
+        p_act->speed = approach_speed(p_act);
+        p_act->config.bridge_output(output,
+                                    ((p_ahead != NULL) && button_debounce_is_pressed(p_ahead))
+                                    ? ACTUATOR_SPEED_CUT : p_act->speed);
+    }
+
+    p_act->output = output;
+
+    if (p_act->output_deferred != 0U) {
+        p_act->output_dirty = 1U;
+        return;
+    }
+
+    ACTUATOR_PROFILE_START(outputs_start, ACTUATOR_PROFILE_OUTPUTS);
+    write_outputs(p_act, output);
+    ACTUATOR_PROFILE_STOP(outputs_start);
+}
+
+ACTUATOR_RAMFUNC
+static void write_outputs(const ActuatorControl_t *p_act, ActuatorOutput_t output)
+{
+    /* One BSRR store per port: all pins of the port change in the same cycle */
+    for (uint8_t i = 0U; i < p_act->output_port_count; i++) {
+        const ActuatorOutputPort_t *p_out = &p_act->output_ports[i];
+        actuator_gpio_write(p_out->port, p_out->bsrr[output]);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static void cut_outputs(const ActuatorControl_t *p_act)
+{
+    write_outputs(p_act, ACTUATOR_OUTPUT_STOP);
+    if (p_act->config.bridge_output != NULL) {
+        p_act->config.bridge_output(ACTUATOR_OUTPUT_STOP, ACTUATOR_SPEED_CUT);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static uint16_t approach_left(const ActuatorControl_t *p_act)
+{
+    if ((p_act->config.approach_permille == 0U) || (p_act->is_homing != 0U) ||
+        (p_act->target_position != ACTUATOR_POSITION_UNKNOWN) ||
+        (p_act->position == ACTUATOR_POSITION_UNKNOWN)) {
+        return ACTUATOR_POSITION_UNKNOWN;
+    }
+
+    if (p_act->state == ACTUATOR_EXTENDING) {
+        return (uint16_t)(ACTUATOR_POSITION_MAX - p_act->position);
+    }
+    if (p_act->state == ACTUATOR_SHRINKING) {
+        return p_act->position;
+    }
+    return ACTUATOR_POSITION_UNKNOWN;
+}
+
+ACTUATOR_RAMFUNC
+static ActuatorSpeed_t approach_speed(const ActuatorControl_t *p_act)
+{
+    const uint16_t left = approach_left(p_act);
+
+    return ((left != ACTUATOR_POSITION_UNKNOWN) && (left <= p_act->config.approach_permille))
+           ? ACTUATOR_SPEED_APPROACH : ACTUATOR_SPEED_FULL;
+}
+
+ACTUATOR_RAMFUNC
+static uint32_t approach_delay(const ActuatorControl_t *p_act)
+{
+    const uint16_t left   = approach_left(p_act);
+    const uint16_t zone   = p_act->config.approach_permille;
+    const uint32_t travel = (p_act->state == ACTUATOR_EXTENDING) ? p_act->extend_time : p_act->shrink_time;
+
+    if ((left == ACTUATOR_POSITION_UNKNOWN) || (left <= zone) || (travel == 0U)) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+
+    /* Rounded up, so the estimate is inside the zone when it is due;
+       travel times are bounded by the homing timeout, so the product fits */
+    uint32_t ticks = (((uint32_t)(left - zone) * travel) + (ACTUATOR_POSITION_MAX - 1U)) /
+                     ACTUATOR_POSITION_MAX;
+    if (encoder_ready(p_act) != 0U) {
+        ticks /= 2U;
+    }
+    return (ticks == 0U) ? 1U : ticks;
+}
+
+ACTUATOR_RAMFUNC
+static void update_speed(ActuatorControl_t *p_act)
+{
+    const ActuatorSpeed_t speed = approach_speed(p_act);
+
+    if ((speed == p_act->speed) ||
+        (p_act->limit_latch != LIMIT_LATCH_NONE) || (p_act->stall_latch != 0U)) {
+        return;
+    }
+
+    p_act->speed = speed;
+    if (p_act->output != ACTUATOR_OUTPUT_STOP) {
+        p_act->config.bridge_output(p_act->output, speed);
+    }
+}
+
+static void add_output_pin(ActuatorControl_t *p_act,
+                           void *port,
+                           uint16_t pin,
+                           const uint8_t levels[ACTUATOR_OUTPUT_COUNT])
+{
+    uint8_t i = 0U;
+
+    if (port == NULL) {
+        return;                                 /* No relay: the H-bridge drives the motor */
+    }
+
+    /* Find the entry for this port, or claim the next free one */
+    while ((i < p_act->output_port_count) && (p_act->output_ports[i].port != port)) {
+        i++;
+    }
+    if (i == p_act->output_port_count) {
+        if (i >= ACTUATOR_MAX_OUTPUT_PORTS) {
+            return;
+        }
+        p_act->output_ports[i].port = port;
+        for (uint8_t k = 0U; k < (uint8_t)ACTUATOR_OUTPUT_COUNT; k++) {
+            p_act->output_ports[i].bsrr[k] = 0U;
+        }
+        p_act->output_port_count++;
+    }
+
+    for (uint8_t k = 0U; k < (uint8_t)ACTUATOR_OUTPUT_COUNT; k++) {
+        p_act->output_ports[i].bsrr[k] |= actuator_gpio_bsrr(pin, levels[k]);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static void update_switches(ActuatorControl_t *p_act, uint32_t current_time)
+{
+    ACTUATOR_PROFILE_START(switches_start, ACTUATOR_PROFILE_SWITCHES);
+
+    button_debounce_update(&p_act->extend_switch,
+                           actuator_gpio_read_pin(p_act->config.extend_switch_port,
+                                                  p_act->config.extend_switch_pin),
                            current_time);
 
     button_debounce_update(&p_act->shrink_switch,
-                           (uint8_t)HAL_GPIO_ReadPin(
-                               (GPIO_TypeDef*)p_act->config.shrink_switch_port,
-                               p_act->config.shrink_switch_pin),
+                           actuator_gpio_read_pin(p_act->config.shrink_switch_port,
+                                                  p_act->config.shrink_switch_pin),
                            current_time);
+
+    ACTUATOR_PROFILE_STOP(switches_start);
 }
\ No newline at end of file
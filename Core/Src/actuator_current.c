@@ -0,0 +1,134 @@
+/**
+ * @file    actuator_current.c
+ * @brief   Streaming motor-stall detector over a circular buffer of current
+ *          samples.
+ */
+
+#include "actuator_current.h"
+
+#include <stddef.h>
+
+#include "actuator_ramfunc.h"       /* Runs from the DMA interrupt */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/** Largest block: 2^8 samples of 16 bits still sum in 32 bits. */
+#define CURRENT_MAX_BLOCK_SHIFT     8U
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Judge one complete block.
+ * @return 1 if this block completed a stall, 0 otherwise.
+ */
+ACTUATOR_RAMFUNC
+static uint8_t current_block(ActuatorCurrent_t *p_cur, uint16_t level)
+{
+    p_cur->level = level;
+
+    if ((p_cur->running == 0U) || (p_cur->stalled != 0U)) {
+        return 0U;
+    }
+    if (p_cur->blank != 0U) {
+        p_cur->blank--;                         /* Inrush */
+        return 0U;
+    }
+
+    p_cur->peak = (level > p_cur->peak) ? level : p_cur->peak;
+
+    if (level < p_cur->config.threshold) {
+        p_cur->over = 0U;
+        return 0U;
+    }
+    if (++p_cur->over < p_cur->config.stall_blocks) {
+        return 0U;
+    }
+
+    p_cur->stalled = 1U;
+    return 1U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+uint8_t actuator_current_init(ActuatorCurrent_t *p_cur,
+                              const volatile uint16_t *p_ring,
+                              uint16_t size,
+                              const ActuatorCurrentConfig_t *p_cfg)
+{
+    if ((p_cur == NULL) || (p_cfg == NULL) || (p_cfg->block_shift > CURRENT_MAX_BLOCK_SHIFT) ||
+        (size < 2U) || ((size & (uint16_t)(size - 1U)) != 0U)) {
+        return 0U;
+    }
+
+    p_cur->config   = *p_cfg;
+    p_cur->p_ring   = p_ring;
+    p_cur->mask     = (uint16_t)(size - 1U);
+    p_cur->read_pos = 0U;
+    p_cur->sum      = 0U;
+    p_cur->count    = 0U;
+    p_cur->level    = 0U;
+    p_cur->peak     = 0U;
+    p_cur->blank    = 0U;
+    p_cur->over     = 0U;
+    p_cur->running  = 0U;
+    p_cur->stalled  = 0U;
+    return 1U;
+}
+
+ACTUATOR_RAMFUNC
+void actuator_current_set_running(ActuatorCurrent_t *p_cur, uint8_t running)
+{
+    if (p_cur == NULL) {
+        return;
+    }
+
+    if ((running != 0U) && (running != p_cur->running)) {
+        p_cur->blank   = p_cur->config.blank_blocks;
+        p_cur->over    = 0U;
+        p_cur->peak    = 0U;
+        p_cur->stalled = 0U;
+    }
+    p_cur->running = running;
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_current_feed(ActuatorCurrent_t *p_cur, uint16_t sample)
+{
+    if (p_cur == NULL) {
+        return 0U;
+    }
+
+    p_cur->sum += sample;
+    if (++p_cur->count < (uint16_t)(1U << p_cur->config.block_shift)) {
+        return 0U;
+    }
+
+    const uint16_t level = (uint16_t)(p_cur->sum >> p_cur->config.block_shift);
+    p_cur->sum   = 0U;
+    p_cur->count = 0U;
+    return current_block(p_cur, level);
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_current_process(ActuatorCurrent_t *p_cur, uint16_t write_pos)
+{
+    if ((p_cur == NULL) || (p_cur->p_ring == NULL)) {
+        return 0U;
+    }
+
+    const uint16_t mask  = p_cur->mask;
+    uint8_t        stall = 0U;
+
+    write_pos &= mask;
+    while (p_cur->read_pos != write_pos) {
+        stall |= actuator_current_feed(p_cur, p_cur->p_ring[p_cur->read_pos]);
+        p_cur->read_pos = (uint16_t)((p_cur->read_pos + 1U) & mask);
+    }
+    return stall;
+}
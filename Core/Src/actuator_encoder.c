@@ -0,0 +1,101 @@
+/**
+ * @file    actuator_encoder.c
+ * @brief   TIM2 encoder mode on PA0/PA1, 32-bit count from the update interrupt.
+ */
+
+#include "actuator_encoder.h"
+
+#include "main.h"                   /* HAL, CMSIS */
+#include "actuator_ramfunc.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/* Fixed by the pin map: TIM2_CH1 is PA0, TIM2_CH2 is PA1 */
+#define ENCODER_A_Pin               GPIO_PIN_0
+#define ENCODER_B_Pin               GPIO_PIN_1
+#define ENCODER_GPIO_Port           GPIOA
+
+/* SMS = 011: count on both edges of TI1 and TI2 */
+#define ENCODER_SMS_MODE3           (TIM_SMCR_SMS_0 | TIM_SMCR_SMS_1)
+
+/* ICxF = 0110: fDTS / 4, N = 6 — ignores pulses below about 0.3 µs at 72 MHz */
+#define ENCODER_IC_FILTER           6U
+
+/* Same level as the timebase capture: a missed wrap loses 65536 counts */
+#define ENCODER_IRQ_PRIORITY        1U
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static volatile int32_t s_high;             /* Wraps of the 16-bit counter, signed */
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void actuator_encoder_init(uint8_t inverted)
+{
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_TIM2_CLK_ENABLE();
+
+    /* ---- PA0 / PA1 inputs, pulled up for open-collector encoders ---- */
+    gpio.Pin  = ENCODER_A_Pin | ENCODER_B_Pin;
+    gpio.Mode = GPIO_MODE_INPUT;
+    gpio.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(ENCODER_GPIO_Port, &gpio);
+
+    /* ---- TIM2: encoder mode 3 on TI1 / TI2, full 16-bit range ---- */
+    TIM2->CR1   = 0U;
+    TIM2->SMCR  = ENCODER_SMS_MODE3;
+    TIM2->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_0 |
+                  (ENCODER_IC_FILTER << TIM_CCMR1_IC1F_Pos) |
+                  (ENCODER_IC_FILTER << TIM_CCMR1_IC2F_Pos);
+    TIM2->CCER  = (inverted != 0U) ? TIM_CCER_CC1P : 0U;    /* Inverting TI1 reverses the count */
+    TIM2->PSC   = 0U;
+    TIM2->ARR   = 0xFFFFU;
+    TIM2->CNT   = 0U;
+    s_high      = 0;
+    TIM2->SR    = 0U;
+    TIM2->DIER  = TIM_DIER_UIE;
+    TIM2->CR1   = TIM_CR1_CEN;
+
+    HAL_NVIC_SetPriority(TIM2_IRQn, ENCODER_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+ACTUATOR_RAMFUNC
+int32_t actuator_encoder_count(void)
+{
+    int32_t  high;
+    uint32_t pending;
+    uint16_t low;
+
+    /* A wrap whose interrupt has not run yet is folded in here; the
+       counter is then near 0 after an overflow, near 0xFFFF after an underflow */
+    do {
+        high    = s_high;
+        pending = TIM2->SR & TIM_SR_UIF;
+        low     = (uint16_t)TIM2->CNT;
+    } while ((high != s_high) || (pending != (TIM2->SR & TIM_SR_UIF)));
+
+    if (pending != 0U) {
+        high += (low < 0x8000U) ? 1 : -1;
+    }
+    return (int32_t)(((uint32_t)high << 16U) | low);
+}
+
+void actuator_encoder_irq_handler(void)
+{
+    if ((TIM2->SR & TIM_SR_UIF) == 0U) {
+        return;
+    }
+
+    TIM2->SR = ~TIM_SR_UIF;
+    /* Judge by the value, not DIR: the rod may have reversed since the wrap */
+    s_high += (TIM2->CNT < 0x8000U) ? 1 : -1;
+}
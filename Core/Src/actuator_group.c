@@ -0,0 +1,323 @@
+/**
+ * @file    actuator_group.c
+ * @brief   Several actuators driven from one update pass.
+ *
+ * The actuators run with deferred outputs (#actuator_defer_outputs()); after
+ * all of them were updated, each changed pattern is OR-ed into the BSRR word
+ * of its ports. Pins of different actuators are disjoint, so the merged word
+ * touches exactly the pins that change.
+ *
+ * The limit switches are debounced per port (#ButtonDebouncePort_t), not per
+ * actuator; the actuators get the debounced states through
+ * #actuator_update_debounced().
+ */
+
+#include "actuator_group.h"
+#include "actuator_gpio.h"          /* Inline IDR / BSRR access (LL or HAL) */
+#include "actuator_ramfunc.h"
+
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Find a port in the group, or append it.
+ * @return Port index, or #ACTUATOR_GROUP_NO_PORT if the table is full.
+ */
+static uint8_t group_port_index(ActuatorGroup_t *p_group, void *port)
+{
+    uint8_t i = 0U;
+
+    while ((i < p_group->port_count) && (p_group->ports[i].port != port)) {
+        i++;
+    }
+    if (i == p_group->port_count) {
+        if (i >= ACTUATOR_GROUP_MAX_PORTS) {
+            return ACTUATOR_GROUP_NO_PORT;
+        }
+        p_group->ports[i].port     = port;
+        p_group->ports[i].is_input = 0U;
+        p_group->ports[i].idr      = 0U;
+        p_group->ports[i].bsrr     = 0U;
+        p_group->port_count++;
+    }
+    return i;
+}
+
+/**
+ * @brief  Set up the debouncer of every input port for the switches on it.
+ *         One sample per tick: `debounce_time_ms + 1` samples match the
+ *         delay of #ButtonDebounce_t; the slowest actuator with a switch
+ *         on the port sets its count.
+ */
+static void group_debounce_init(ActuatorGroup_t *p_group)
+{
+    for (uint8_t p = 0U; p < p_group->port_count; p++) {
+        uint16_t pin_mask    = 0U;
+        uint16_t active_high = 0U;
+        uint32_t samples     = 1U;
+
+        for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+            const ActuatorControl_t *p_act = &p_group->actuators[a];
+
+            if ((p_group->extend_switch_port[a] != p) && (p_group->shrink_switch_port[a] != p)) {
+                continue;               /* Its delay does not apply to this port */
+            }
+            if (p_group->extend_switch_port[a] == p) {
+                pin_mask    |= p_act->config.extend_switch_pin;
+                active_high |= (p_act->extend_switch.active_state != 0U)
+                               ? p_act->config.extend_switch_pin : 0U;
+            }
+            if (p_group->shrink_switch_port[a] == p) {
+                pin_mask    |= p_act->config.shrink_switch_pin;
+                active_high |= (p_act->shrink_switch.active_state != 0U)
+                               ? p_act->config.shrink_switch_pin : 0U;
+            }
+            if ((p_act->config.debounce_time_ms + 1U) > samples) {
+                samples = p_act->config.debounce_time_ms + 1U;
+            }
+        }
+        if (samples > BUTTON_DEBOUNCE_PORT_MAX_SAMPLES) {
+            samples = BUTTON_DEBOUNCE_PORT_MAX_SAMPLES;
+        }
+        button_debounce_port_init(&p_group->ports[p].debounce, pin_mask, active_high,
+                                  (uint8_t)samples);
+    }
+}
+
+ACTUATOR_RAMFUNC
+static uint8_t group_switch_pressed(const ActuatorGroup_t *p_group, uint8_t port_index, uint16_t pin)
+{
+    return ((p_group->ports[port_index].debounce.pressed & pin) != 0U) ? 1U : 0U;
+}
+
+ACTUATOR_RAMFUNC
+static uint8_t group_pin_level(const ActuatorGroup_t *p_group, uint8_t port_index, uint16_t pin)
+{
+    return ((p_group->ports[port_index].idr & pin) != 0U) ? 1U : 0U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+uint8_t actuator_group_init(ActuatorGroup_t *p_group,
+                            const ActuatorConfig_t *p_cfgs,
+                            uint8_t count)
+{
+    if ((p_group == NULL) || (p_cfgs == NULL) ||
+        (count == 0U) || (count > ACTUATOR_GROUP_MAX_ACTUATORS)) {
+        return 0U;
+    }
+
+    p_group->actuator_count = 0U;
+    p_group->port_count     = 0U;
+
+    for (uint8_t a = 0U; a < count; a++) {
+        ActuatorControl_t *p_act = &p_group->actuators[a];
+
+        actuator_init(p_act, &p_cfgs[a]);
+        actuator_defer_outputs(p_act, 1U);
+        p_act->id = a;
+
+        const uint8_t ext = group_port_index(p_group, p_cfgs[a].extend_switch_port);
+        const uint8_t shr = group_port_index(p_group, p_cfgs[a].shrink_switch_port);
+        if ((ext == ACTUATOR_GROUP_NO_PORT) || (shr == ACTUATOR_GROUP_NO_PORT)) {
+            return 0U;
+        }
+        p_group->ports[ext].is_input    = 1U;
+        p_group->ports[shr].is_input    = 1U;
+        p_group->extend_switch_port[a]  = ext;
+        p_group->shrink_switch_port[a]  = shr;
+
+        for (uint8_t k = 0U; k < ACTUATOR_MAX_OUTPUT_PORTS; k++) {
+            p_group->output_port[a][k] = ACTUATOR_GROUP_NO_PORT;
+        }
+        for (uint8_t k = 0U; k < p_act->output_port_count; k++) {
+            const uint8_t out = group_port_index(p_group, p_act->output_ports[k].port);
+            if (out == ACTUATOR_GROUP_NO_PORT) {
+                return 0U;
+            }
+            p_group->output_port[a][k] = out;
+        }
+    }
+
+    p_group->actuator_count = count;
+    p_group->sample_time    = 0U;
+    p_group->sampled        = 0U;
+    group_debounce_init(p_group);
+    return count;
+}
+
+ActuatorControl_t *actuator_group_get(ActuatorGroup_t *p_group, uint8_t index)
+{
+    if ((p_group == NULL) || (index >= p_group->actuator_count)) {
+        return NULL;
+    }
+    return &p_group->actuators[index];
+}
+
+uint8_t actuator_group_post(ActuatorGroup_t *p_group, const ActuatorCommand_t *p_cmd)
+{
+    if (p_cmd == NULL) {
+        return 0U;
+    }
+    return actuator_post(actuator_group_get(p_group, p_cmd->index), p_cmd);
+}
+
+ACTUATOR_RAMFUNC
+void actuator_group_update(ActuatorGroup_t *p_group, uint32_t current_time)
+{
+    if (p_group == NULL) {
+        return;
+    }
+
+    ActuatorOutput_t output[ACTUATOR_GROUP_MAX_ACTUATORS];
+    uint8_t          taken  = 0U;                   /* Bit a: output[a] is valid */
+    const uint8_t    sample = ((p_group->sampled == 0U) ||
+                               (current_time != p_group->sample_time)) ? 1U : 0U;
+
+    p_group->sample_time = current_time;
+    p_group->sampled     = 1U;
+
+    /* ---- One IDR read and one debounce step per input port ---- */
+    for (uint8_t p = 0U; p < p_group->port_count; p++) {
+        ActuatorGroupPort_t *p_port = &p_group->ports[p];
+
+        if (p_port->is_input != 0U) {
+            p_port->idr = actuator_gpio_read(p_port->port);
+            if (sample != 0U) {
+                (void)button_debounce_port_update(&p_port->debounce, p_port->idr);
+            }
+        }
+    }
+
+    /* ---- State machines ---- */
+    for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+        ActuatorControl_t *p_act = &p_group->actuators[a];
+
+        actuator_update_debounced(p_act,
+                                  group_switch_pressed(p_group, p_group->extend_switch_port[a],
+                                                       p_act->config.extend_switch_pin),
+                                  group_switch_pressed(p_group, p_group->shrink_switch_port[a],
+                                                       p_act->config.shrink_switch_pin),
+                                  group_pin_level(p_group, p_group->extend_switch_port[a],
+                                                  p_act->config.extend_switch_pin),
+                                  group_pin_level(p_group, p_group->shrink_switch_port[a],
+                                                  p_act->config.shrink_switch_pin),
+                                  current_time);
+
+        if ((p_act->output_dirty != 0U) && (actuator_take_output(p_act, &output[a]) != 0U)) {
+            taken |= (uint8_t)(1U << a);
+        }
+    }
+    if (taken == 0U) {
+        return;                                 /* Usual pass: no output changed */
+    }
+
+    /* ---- Outputs collected per port, right before the stores: a relay the
+       EXTI or stall ISR cut since the take must not be re-energised by a
+       stale EXTEND / SHRINK pattern ---- */
+    for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+        const ActuatorControl_t *p_act = &p_group->actuators[a];
+
+        if ((taken & (1U << a)) == 0U) {
+            continue;
+        }
+        if (actuator_output_cut(p_act) != 0U) {
+            output[a] = ACTUATOR_OUTPUT_STOP;
+        }
+        for (uint8_t k = 0U; k < p_act->output_port_count; k++) {
+            p_group->ports[p_group->output_port[a][k]].bsrr |= p_act->output_ports[k].bsrr[output[a]];
+        }
+    }
+
+    /* ---- One BSRR store per port that changed; bsrr is left cleared ---- */
+    for (uint8_t p = 0U; p < p_group->port_count; p++) {
+        ActuatorGroupPort_t *p_port = &p_group->ports[p];
+
+        if (p_port->bsrr != 0U) {
+            actuator_gpio_write(p_port->port, p_port->bsrr);
+            p_port->bsrr = 0U;
+        }
+    }
+}
+
+uint32_t actuator_group_next_deadline(const ActuatorGroup_t *p_group, uint32_t current_time)
+{
+    if (p_group == NULL) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+
+    uint32_t delay = ACTUATOR_NO_DEADLINE;
+
+    for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+        const uint32_t d = actuator_next_deadline(&p_group->actuators[a], current_time);
+        if (d < delay) {
+            delay = d;
+        }
+    }
+
+    /* ---- A switch still counting needs its sample every tick ---- */
+    for (uint8_t p = 0U; (p < p_group->port_count) && (delay > 1U); p++) {
+        const ButtonDebouncePort_t *p_deb = &p_group->ports[p].debounce;
+
+        if ((p_deb->count0 | p_deb->count1 | p_deb->count2) != 0U) {
+            delay = 1U;
+        }
+    }
+    return delay;
+}
+
+uint8_t actuator_group_is_idle(const ActuatorGroup_t *p_group)
+{
+    if (p_group == NULL) {
+        return 1U;
+    }
+
+    for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+        const ActuatorControl_t *p_act = &p_group->actuators[a];
+        const ActuatorState_t    state = actuator_get_state(p_act);
+
+        if ((state == ACTUATOR_EXTENDING) || (state == ACTUATOR_SHRINKING) ||
+            (actuator_is_homing(p_act) != 0U)) {
+            return 0U;
+        }
+    }
+    return 1U;
+}
+
+ACTUATOR_RAMFUNC
+void actuator_group_limit_switch_isr(ActuatorGroup_t *p_group, uint16_t gpio_pin)
+{
+    if (p_group == NULL) {
+        return;
+    }
+
+    /* One EXTI line per pin number — the actuator checks its own port level */
+    for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+        actuator_limit_switch_isr(&p_group->actuators[a], gpio_pin);
+    }
+}
+
+void actuator_group_switch_edge(ActuatorGroup_t *p_group, void *port,
+                                uint16_t gpio_pin, uint32_t timestamp_us)
+{
+    if (p_group == NULL) {
+        return;
+    }
+
+    /* Pin numbers repeat across ports — the port picks the one actuator */
+    for (uint8_t a = 0U; a < p_group->actuator_count; a++) {
+        ActuatorControl_t      *p_act = &p_group->actuators[a];
+        const ActuatorConfig_t *p_cfg = &p_act->config;
+
+        if (((p_cfg->extend_switch_port == port) && (p_cfg->extend_switch_pin == gpio_pin)) ||
+            ((p_cfg->shrink_switch_port == port) && (p_cfg->shrink_switch_pin == gpio_pin))) {
+            actuator_switch_edge(p_act, gpio_pin, timestamp_us);
+            return;
+        }
+    }
+}
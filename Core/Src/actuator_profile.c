@@ -0,0 +1,162 @@
+/**
+ * @file    actuator_profile.c
+ * @brief   Opt-in cycle-count instrumentation for the actuator control loop.
+ *
+ * Compiles to an empty translation unit unless ACTUATOR_PROFILE_ENABLED.
+ */
+
+#include "actuator_profile.h"
+#include "actuator_ramfunc.h"       /* Placement shown in the dump header */
+
+#if ACTUATOR_PROFILE_ENABLED
+
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+ActuatorProfile_t actuator_profile;
+
+static const char *const s_slot_names[ACTUATOR_PROFILE_SLOT_COUNT] = {
+    "update.idle",
+    "update.extending",
+    "update.shrinking",
+    "update.error",
+    "update.homing",
+    "switches",
+    "outputs",
+    "loop.pass"
+};
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/** Append `value` in decimal, right-aligned in `width` columns. */
+static uint16_t profile_append_u32(char *p_buf, uint16_t pos, uint32_t value, uint8_t width)
+{
+    char    digits[10];
+    uint8_t n = 0U;
+
+    do {
+        digits[n++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+
+    while (width > n) {
+        p_buf[pos++] = ' ';
+        width--;
+    }
+    while (n > 0U) {
+        p_buf[pos++] = digits[--n];
+    }
+    return pos;
+}
+
+static uint16_t profile_append_str(char *p_buf, uint16_t pos, const char *p_text, uint8_t width)
+{
+    while (*p_text != '\0') {
+        p_buf[pos++] = *p_text++;
+        if (width > 0U) {
+            width--;
+        }
+    }
+    while (width > 0U) {
+        p_buf[pos++] = ' ';
+        width--;
+    }
+    return pos;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void actuator_profile_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0U;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+    actuator_profile.overhead = 0U;
+    actuator_profile_reset();
+
+    /* Cost of the START/STOP pair itself, best of a few */
+    uint32_t overhead = 0xFFFFFFFFU;
+    for (uint8_t i = 0U; i < 8U; i++) {
+        const uint32_t start  = DWT->CYCCNT;
+        const uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < overhead) {
+            overhead = cycles;
+        }
+    }
+    actuator_profile.overhead = overhead;
+}
+
+void actuator_profile_reset(void)
+{
+    for (uint8_t i = 0U; i < (uint8_t)ACTUATOR_PROFILE_SLOT_COUNT; i++) {
+        actuator_profile.slots[i].count = 0U;
+        actuator_profile.slots[i].min   = 0xFFFFFFFFU;
+        actuator_profile.slots[i].max   = 0U;
+        actuator_profile.slots[i].total = 0U;
+    }
+}
+
+void actuator_profile_record(ActuatorProfileSlot_t slot, uint32_t cycles)
+{
+    if ((uint32_t)slot >= (uint32_t)ACTUATOR_PROFILE_SLOT_COUNT) {
+        return;
+    }
+
+    ActuatorProfileStats_t *p_stats = &actuator_profile.slots[slot];
+
+    cycles = (cycles > actuator_profile.overhead) ? (cycles - actuator_profile.overhead) : 0U;
+
+    p_stats->count++;
+    p_stats->total += cycles;
+    if (cycles < p_stats->min) {
+        p_stats->min = cycles;
+    }
+    if (cycles > p_stats->max) {
+        p_stats->max = cycles;
+    }
+}
+
+void actuator_profile_dump(void (*p_write)(const char *p_text, uint16_t length))
+{
+    char line[80];
+
+    if (p_write == NULL) {
+        return;
+    }
+
+    uint16_t pos = 0U;
+    pos = profile_append_str(line, pos,
+                             (ACTUATOR_RAMFUNC_ENABLED != 0U) ? "# hot path in SRAM\r\n"
+                                                              : "# hot path in flash\r\n", 0U);
+    p_write(line, pos);
+
+    pos = 0U;
+    pos = profile_append_str(line, pos, "# slot", 18U);
+    pos = profile_append_str(line, pos, "     count       min       avg       max (cycles)\r\n", 0U);
+    p_write(line, pos);
+
+    for (uint8_t i = 0U; i < (uint8_t)ACTUATOR_PROFILE_SLOT_COUNT; i++) {
+        const ActuatorProfileStats_t *p_stats = &actuator_profile.slots[i];
+        const uint32_t avg = (p_stats->count != 0U) ? (uint32_t)(p_stats->total / p_stats->count) : 0U;
+
+        pos = 0U;
+        pos = profile_append_str(line, pos, s_slot_names[i], 18U);
+        pos = profile_append_u32(line, pos, p_stats->count, 10U);
+        pos = profile_append_u32(line, pos, (p_stats->count != 0U) ? p_stats->min : 0U, 10U);
+        pos = profile_append_u32(line, pos, avg, 10U);
+        pos = profile_append_u32(line, pos, p_stats->max, 10U);
+        line[pos++] = '\r';
+        line[pos++] = '\n';
+        p_write(line, pos);
+    }
+}
+
+#endif /* ACTUATOR_PROFILE_ENABLED */
@@ -0,0 +1,82 @@
+/**
+ * @file    actuator_queue.c
+ * @brief   Lock-free single-producer / single-consumer command queue.
+ *
+ * The Cortex-M3 is single-core and keeps its own loads and stores in
+ * program order, so an ISR and the main loop only need the compiler not to
+ * reorder the slot copy across the index update — no DMB, no masking.
+ */
+
+#include "actuator_queue.h"
+#include "actuator_ramfunc.h"       /* Pop in SRAM on the target */
+
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+#define QUEUE_MASK          ((uint8_t)(ACTUATOR_QUEUE_SIZE - 1U))
+
+/** Keep the slot access on its side of the index update. */
+#define QUEUE_BARRIER()     __asm volatile ("" ::: "memory")
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+void actuator_queue_init(ActuatorQueue_t *p_queue)
+{
+    if (p_queue == NULL) {
+        return;
+    }
+
+    p_queue->head = 0U;
+    p_queue->tail = 0U;
+}
+
+uint8_t actuator_queue_push(ActuatorQueue_t *p_queue, const ActuatorCommand_t *p_cmd)
+{
+    if ((p_queue == NULL) || (p_cmd == NULL)) {
+        return 0U;
+    }
+
+    const uint8_t head = p_queue->head;
+
+    if ((uint8_t)(head - p_queue->tail) >= ACTUATOR_QUEUE_SIZE) {
+        return 0U;
+    }
+
+    p_queue->slots[head & QUEUE_MASK] = *p_cmd;
+    QUEUE_BARRIER();                            /* Record complete before it is published */
+    p_queue->head = (uint8_t)(head + 1U);
+    return 1U;
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_queue_pop(ActuatorQueue_t *p_queue, ActuatorCommand_t *p_cmd)
+{
+    if ((p_queue == NULL) || (p_cmd == NULL)) {
+        return 0U;
+    }
+
+    const uint8_t tail = p_queue->tail;
+
+    if (tail == p_queue->head) {
+        return 0U;
+    }
+
+    QUEUE_BARRIER();                            /* Read the record only after seeing head */
+    *p_cmd = p_queue->slots[tail & QUEUE_MASK];
+    QUEUE_BARRIER();                            /* Copy out before the slot is released   */
+    p_queue->tail = (uint8_t)(tail + 1U);
+    return 1U;
+}
+
+uint8_t actuator_queue_pending(const ActuatorQueue_t *p_queue)
+{
+    if (p_queue == NULL) {
+        return 0U;
+    }
+    return (p_queue->head != p_queue->tail) ? 1U : 0U;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file    actuator_ramp.c
+ * @brief   Duty-cycle ramp generator for an H-bridge motor drive.
+ */
+
+#include "actuator_ramp.h"
+
+#include <stddef.h>
+
+#include "actuator_ramfunc.h"       /* Runs from the timer interrupt */
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Duty change per step that covers `duty` in `ms`, rounded up.
+ * @return `duty` itself for ms = 0, at least 1.
+ */
+static uint16_t ramp_step_size(uint16_t duty, uint16_t ms, uint16_t step_hz)
+{
+    const uint32_t steps = ((uint32_t)ms * step_hz) / 1000U;
+    const uint32_t size  = (steps == 0U) ? duty : (((uint32_t)duty + steps - 1U) / steps);
+
+    return (size == 0U) ? 1U : (uint16_t)size;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+uint8_t actuator_ramp_init(ActuatorRamp_t *p_ramp, const ActuatorRampConfig_t *p_cfg)
+{
+    if ((p_ramp == NULL) || (p_cfg == NULL) || (p_cfg->step_hz == 0U) ||
+        (p_cfg->full_duty == 0U) || (p_cfg->approach_duty > p_cfg->full_duty)) {
+        return 0U;
+    }
+
+    p_ramp->config     = *p_cfg;
+    p_ramp->accel_step = ramp_step_size(p_cfg->full_duty, p_cfg->accel_ms, p_cfg->step_hz);
+    p_ramp->decel_step = ramp_step_size(p_cfg->full_duty, p_cfg->decel_ms, p_cfg->step_hz);
+    p_ramp->request    = ACTUATOR_OUTPUT_STOP;
+    p_ramp->target     = 0U;
+    p_ramp->direction  = ACTUATOR_OUTPUT_STOP;
+    p_ramp->duty       = 0U;
+    return 1U;
+}
+
+ACTUATOR_RAMFUNC
+void actuator_ramp_set(ActuatorRamp_t *p_ramp, ActuatorOutput_t output, ActuatorSpeed_t speed)
+{
+    if (p_ramp == NULL) {
+        return;
+    }
+
+    if (speed == ACTUATOR_SPEED_CUT) {
+        p_ramp->duty      = 0U;
+        p_ramp->direction = ACTUATOR_OUTPUT_STOP;
+    }
+
+    p_ramp->request = output;
+    p_ramp->target  = (output == ACTUATOR_OUTPUT_STOP) ? 0U
+                    : (speed == ACTUATOR_SPEED_APPROACH) ? p_ramp->config.approach_duty
+                    : p_ramp->config.full_duty;
+}
+
+ACTUATOR_RAMFUNC
+uint8_t actuator_ramp_step(ActuatorRamp_t *p_ramp)
+{
+    if (p_ramp == NULL) {
+        return 0U;
+    }
+
+    if (p_ramp->direction != p_ramp->request) {
+        if (p_ramp->duty != 0U) {
+            /* Slow down in the old direction; turn round one step after rest */
+            p_ramp->duty = (p_ramp->duty > p_ramp->decel_step)
+                           ? (uint16_t)(p_ramp->duty - p_ramp->decel_step) : 0U;
+            if (p_ramp->duty == 0U) {
+                p_ramp->direction = ACTUATOR_OUTPUT_STOP;
+            }
+            return ((p_ramp->duty != p_ramp->target) || (p_ramp->direction != p_ramp->request)) ? 1U : 0U;
+        }
+        p_ramp->direction = p_ramp->request;
+    }
+
+    if (p_ramp->duty < p_ramp->target) {
+        const uint16_t room = (uint16_t)(p_ramp->target - p_ramp->duty);
+        p_ramp->duty = (room > p_ramp->accel_step) ? (uint16_t)(p_ramp->duty + p_ramp->accel_step)
+                                                   : p_ramp->target;
+    } else if (p_ramp->duty > p_ramp->target) {
+        const uint16_t room = (uint16_t)(p_ramp->duty - p_ramp->target);
+        p_ramp->duty = (room > p_ramp->decel_step) ? (uint16_t)(p_ramp->duty - p_ramp->decel_step)
+                                                   : p_ramp->target;
+    }
+
+    if (p_ramp->duty == 0U) {
+        p_ramp->direction = ACTUATOR_OUTPUT_STOP;
+    }
+    return ((p_ramp->duty != p_ramp->target) || (p_ramp->direction != p_ramp->request)) ? 1U : 0U;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file    actuator_storage.c
+ * @brief   Calibration persistence for the actuator control module.
+ *
+ * The reserved page is scanned front to back at boot; the last slot whose
+ * magic is not erased is the current record. Writes only ever program
+ * erased half-words, so a record is written once and later only has its
+ * `in_motion` marker cleared.
+ */
+
+#include "actuator_storage.h"
+
+#include <stddef.h>
+#include "stm32f1xx_hal.h"          /* HAL_FLASH_* (only in .c) */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/** Reserved flash page, provided by STM32F103C8TX_FLASH.ld. */
+extern uint32_t _calib_start;
+extern uint32_t _calib_end;
+
+#define CALIB_START         ((uintptr_t)&_calib_start)
+#define CALIB_END           ((uintptr_t)&_calib_end)
+#define CALIB_RECORD_SIZE   ((uint32_t)sizeof(ActuatorCalibRecord_t))
+
+#define FLASH_ERASED_WORD   0xFFFFFFFFUL
+#define FLASH_ERASED_HALF   0xFFFFU
+
+/** Bytes covered by the CRC: everything up to (not including) `crc`. */
+#define CALIB_CRC_LENGTH    ((uint32_t)offsetof(ActuatorCalibRecord_t, crc))
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Bitwise CRC-32 (IEEE 802.3, reflected). The F103 CRC unit uses a
+ *         different bit order and is not worth enabling for 16 bytes.
+ */
+static uint32_t calib_crc32(const uint8_t *p_data, uint32_t length)
+{
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (uint32_t i = 0U; i < length; i++) {
+        crc ^= p_data[i];
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return ~crc;
+}
+
+static const ActuatorCalibRecord_t *calib_record_at(uintptr_t addr)
+{
+    return (const ActuatorCalibRecord_t *)addr;
+}
+
+/** Address of the first erased slot, or 0 if the page is full. */
+static uintptr_t calib_find_free_slot(void)
+{
+    for (uintptr_t addr = CALIB_START; (addr + CALIB_RECORD_SIZE) <= CALIB_END; addr += CALIB_RECORD_SIZE) {
+        if (calib_record_at(addr)->magic == FLASH_ERASED_WORD) {
+            return addr;
+        }
+    }
+    return 0U;
+}
+
+static HAL_StatusTypeDef calib_erase_page(void)
+{
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase   = FLASH_TYPEERASE_PAGES,
+        .Banks       = FLASH_BANK_1,
+        .PageAddress = CALIB_START,
+        .NbPages     = (CALIB_END - CALIB_START) / FLASH_PAGE_SIZE
+    };
+    uint32_t page_error = 0U;
+
+    return HAL_FLASHEx_Erase(&erase, &page_error);
+}
+
+/** Program `length` bytes (multiple of 4) from `p_src` at `addr`. */
+static HAL_StatusTypeDef calib_program(uintptr_t addr, const void *p_src, uint32_t length)
+{
+    const uint32_t *p_word = (const uint32_t *)p_src;
+
+    for (uint32_t offset = 0U; offset < length; offset += 4U) {
+        const HAL_StatusTypeDef status =
+            HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr + offset, *p_word++);
+        if (status != HAL_OK) {
+            return status;
+        }
+    }
+    return HAL_OK;
+}
+
+static uint8_t actuator_is_moving(const ActuatorControl_t *p_act)
+{
+    const ActuatorState_t state = actuator_get_state(p_act);
+    return ((state == ACTUATOR_EXTENDING) || (state == ACTUATOR_SHRINKING)) ? 1U : 0U;
+}
+
+/** Ticks until a new record is due, ignoring the rest of the group. */
+static uint32_t storage_save_delay(const ActuatorStorage_t *p_store,
+                                   const ActuatorControl_t *p_act,
+                                   uint32_t current_time)
+{
+    if ((p_store->dirty == 0U) || (actuator_is_moving(p_act) != 0U) ||
+        (actuator_is_calibrated(p_act) == 0U) ||
+        (actuator_get_position(p_act) == ACTUATOR_POSITION_UNKNOWN)) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+
+    /* A new homing result is worth an immediate write; a new position only
+       once per interval */
+    if ((p_act->extend_time != p_store->extend_time) || (p_act->shrink_time != p_store->shrink_time)) {
+        return 0U;
+    }
+
+    const uint32_t elapsed = current_time - p_store->save_time;
+    return (elapsed >= ACTUATOR_STORAGE_SAVE_INTERVAL_MS) ? 0U : (ACTUATOR_STORAGE_SAVE_INTERVAL_MS - elapsed);
+}
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+ActuatorStorageStatus_t actuator_storage_load(ActuatorStorage_t *p_store,
+                                              ActuatorControl_t *p_act)
+{
+    if ((p_store == NULL) || (p_act == NULL)) {
+        return ACTUATOR_STORAGE_ERROR;
+    }
+
+    p_store->slot_addr     = 0U;
+    p_store->extend_time   = 0U;
+    p_store->shrink_time   = 0U;
+    p_store->save_time     = 0U;
+    p_store->was_moving    = 0U;
+    p_store->motion_marked = 0U;
+    p_store->dirty         = 0U;
+
+    const uintptr_t free_slot = calib_find_free_slot();
+    const uintptr_t last_slot = (free_slot != 0U) ? free_slot : CALIB_END;
+
+    if (last_slot == CALIB_START) {
+        return ACTUATOR_STORAGE_EMPTY;
+    }
+
+    p_store->slot_addr = last_slot - CALIB_RECORD_SIZE;
+    const ActuatorCalibRecord_t *p_rec = calib_record_at(p_store->slot_addr);
+
+    if ((p_rec->magic != ACTUATOR_STORAGE_MAGIC) ||
+        (p_rec->crc != calib_crc32((const uint8_t *)p_rec, CALIB_CRC_LENGTH))) {
+        return ACTUATOR_STORAGE_CORRUPT;
+    }
+    if (p_rec->version != ACTUATOR_STORAGE_VERSION) {
+        return ACTUATOR_STORAGE_VERSION_MISMATCH;
+    }
+    if (p_rec->in_motion != FLASH_ERASED_HALF) {
+        p_store->motion_marked = 1U;
+        return ACTUATOR_STORAGE_STALE;
+    }
+
+    actuator_restore_calibration(p_act, p_rec->extend_time, p_rec->shrink_time, p_rec->position);
+    if (actuator_is_calibrated(p_act) == 0U) {
+        return ACTUATOR_STORAGE_CORRUPT;
+    }
+
+    p_store->extend_time = p_rec->extend_time;
+    p_store->shrink_time = p_rec->shrink_time;
+    return ACTUATOR_STORAGE_OK;
+}
+
+ActuatorStorageStatus_t actuator_storage_save(ActuatorStorage_t *p_store,
+                                              const ActuatorControl_t *p_act)
+{
+    if ((p_store == NULL) || (p_act == NULL)) {
+        return ACTUATOR_STORAGE_ERROR;
+    }
+
+    ActuatorCalibRecord_t rec = {
+        .magic       = ACTUATOR_STORAGE_MAGIC,
+        .version     = ACTUATOR_STORAGE_VERSION,
+        .position    = actuator_get_position(p_act),
+        .extend_time = p_act->extend_time,
+        .shrink_time = p_act->shrink_time,
+        .crc         = 0U,
+        .in_motion   = FLASH_ERASED_HALF,
+        .reserved    = FLASH_ERASED_HALF
+    };
+    rec.crc = calib_crc32((const uint8_t *)&rec, CALIB_CRC_LENGTH);
+
+    HAL_StatusTypeDef status = HAL_FLASH_Unlock();
+    uintptr_t         addr   = calib_find_free_slot();
+
+    if ((status == HAL_OK) && (addr == 0U)) {
+        status = calib_erase_page();
+        addr   = CALIB_START;
+    }
+    if (status == HAL_OK) {
+        status = calib_program(addr, &rec, CALIB_RECORD_SIZE);
+        if ((status != HAL_OK) && (addr != CALIB_START)) {
+            /* A slot with an erased magic but programmed bits would fail
+               every retry: start the page over, once */
+            status = calib_erase_page();
+            addr   = CALIB_START;
+            if (status == HAL_OK) {
+                status = calib_program(addr, &rec, CALIB_RECORD_SIZE);
+            }
+        }
+    }
+    (void)HAL_FLASH_Lock();
+
+    if (status != HAL_OK) {
+        p_store->slot_addr = 0U;
+        return ACTUATOR_STORAGE_ERROR;
+    }
+
+    p_store->slot_addr     = addr;
+    p_store->extend_time   = rec.extend_time;
+    p_store->shrink_time   = rec.shrink_time;
+    p_store->motion_marked = 0U;
+    p_store->dirty         = 0U;
+    return ACTUATOR_STORAGE_OK;
+}
+
+void actuator_storage_service(ActuatorStorage_t *p_store,
+                              const ActuatorControl_t *p_act,
+                              uint8_t group_idle,
+                              uint32_t current_time)
+{
+    if ((p_store == NULL) || (p_act == NULL)) {
+        return;
+    }
+
+    const uint8_t moving = actuator_is_moving(p_act);
+
+    if ((moving != 0U) && (p_store->was_moving == 0U) &&
+        (p_store->slot_addr != 0U) && (p_store->motion_marked == 0U)) {
+        /* One half-word program (~50 us): the record stays, but is now stale */
+        const uintptr_t marker = p_store->slot_addr + offsetof(ActuatorCalibRecord_t, in_motion);
+
+        if (HAL_FLASH_Unlock() == HAL_OK) {
+            (void)HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, marker, 0U);
+        }
+        (void)HAL_FLASH_Lock();
+        p_store->motion_marked = 1U;
+    }
+    if (moving != 0U) {
+        p_store->dirty = 1U;
+    }
+    p_store->was_moving = moving;
+
+    /* Program / erase only with every motor at rest: fetch from flash stalls */
+    if ((group_idle != 0U) && (storage_save_delay(p_store, p_act, current_time) == 0U)) {
+        (void)actuator_storage_save(p_store, p_act);
+        p_store->save_time = current_time;      /* A failed write is retried an interval later */
+    }
+}
+
+uint32_t actuator_storage_next_deadline(const ActuatorStorage_t *p_store,
+                                        const ActuatorControl_t *p_act,
+                                        uint8_t group_idle,
+                                        uint32_t current_time)
+{
+    if ((p_store == NULL) || (p_act == NULL) || (group_idle == 0U)) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+    return storage_save_delay(p_store, p_act, current_time);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file    actuator_telemetry.c
+ * @brief   Fixed-size binary telemetry frames, double-buffered for DMA.
+ */
+
+#include "actuator_telemetry.h"
+
+#include <stddef.h>
+
+/* The frame goes on the wire as laid out in RAM (Cortex-M3 is little-endian) */
+_Static_assert(sizeof(ActuatorTelemetryFrame_t) == 24U, "telemetry frame must stay 24 bytes");
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Fill one frame in place from an actuator.
+ */
+static void fill_frame(ActuatorTelemetryFrame_t *p_frame,
+                       const ActuatorControl_t *p_act,
+                       uint8_t index,
+                       uint16_t sequence,
+                       uint32_t current_time)
+{
+    uint8_t switches = 0U;
+
+    if (button_debounce_is_pressed(&p_act->extend_switch)) {
+        switches |= ACTUATOR_TELEMETRY_EXTEND_SW;
+    }
+    if (button_debounce_is_pressed(&p_act->shrink_switch)) {
+        switches |= ACTUATOR_TELEMETRY_SHRINK_SW;
+    }
+
+    p_frame->sync        = ACTUATOR_TELEMETRY_SYNC;
+    p_frame->index       = index;
+    p_frame->state       = (uint8_t)p_act->state;
+    p_frame->homing      = (uint8_t)((uint8_t)p_act->homing_phase |
+                                     ((p_act->is_homing != 0U) ? ACTUATOR_TELEMETRY_HOMING : 0U));
+    p_frame->switches    = switches;
+    p_frame->position    = p_act->position;
+    p_frame->tick        = current_time;
+    p_frame->extend_time = p_act->extend_time;
+    p_frame->shrink_time = p_act->shrink_time;
+    p_frame->sequence    = sequence;
+    p_frame->version     = ACTUATOR_TELEMETRY_VERSION;
+    p_frame->checksum    = 0U;
+
+    const uint8_t *p_byte = (const uint8_t*)p_frame;
+    uint8_t        sum    = 0U;
+    for (uint8_t i = 0U; i < (uint8_t)sizeof(*p_frame); i++) {
+        sum = (uint8_t)(sum + p_byte[i]);
+    }
+    p_frame->checksum = (uint8_t)(0U - sum);
+}
+
+/**
+ * @brief  Hand a filled buffer to the transmitter.
+ * @return Non-zero if the transfer started.
+ */
+static uint8_t send_buffer(ActuatorTelemetry_t *p_tel, const ActuatorTelemetryFrame_t *p_buf,
+                           uint16_t length)
+{
+    p_tel->tx_busy = 1U;
+    if (p_tel->p_tx((const uint8_t*)p_buf, length) == 0U) {
+        p_tel->tx_busy = 0U;
+        p_tel->dropped++;
+        return 0U;
+    }
+    return 1U;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Public API                                                               */
+/* -------------------------------------------------------------------------- */
+
+void actuator_telemetry_init(ActuatorTelemetry_t *p_tel,
+                             uint32_t period,
+                             ActuatorTelemetryTx_t p_tx,
+                             uint32_t current_time)
+{
+    if (p_tel == NULL) {
+        return;
+    }
+
+    p_tel->fill      = 0U;
+    p_tel->tx_busy   = 0U;
+    p_tel->queued    = 0U;
+    p_tel->sequence  = 0U;
+    p_tel->period    = (p_tx != NULL) ? period : 0U;
+    p_tel->next_time = current_time;
+    p_tel->dropped   = 0U;
+    p_tel->idle      = 0U;
+    p_tel->idle_sent = 0U;
+    p_tel->p_tx      = p_tx;
+}
+
+void actuator_telemetry_update(ActuatorTelemetry_t *p_tel,
+                               const ActuatorControl_t *p_acts,
+                               uint8_t count,
+                               uint32_t current_time)
+{
+    if ((p_tel == NULL) || (p_acts == NULL) || (p_tel->period == 0U)) {
+        return;
+    }
+
+    /* ---- Send the buffer filled while the previous one was on the wire ---- */
+    if ((p_tel->queued != 0U) && (p_tel->tx_busy == 0U)) {
+        (void)send_buffer(p_tel, p_tel->frames[p_tel->fill ^ 1U], p_tel->queued);
+        p_tel->queued = 0U;
+    }
+
+    if ((p_tel->idle_sent != 0U) || ((int32_t)(current_time - p_tel->next_time) < 0)) {
+        return;
+    }
+
+    /* Keep the cadence, but never schedule a burst after a long gap */
+    p_tel->next_time += p_tel->period;
+    if ((int32_t)(current_time - p_tel->next_time) >= 0) {
+        p_tel->next_time = current_time + p_tel->period;
+    }
+
+    const uint16_t sequence = p_tel->sequence++;
+
+    if (p_tel->queued != 0U) {
+        p_tel->dropped++;                       /* One buffer on the wire, the other queued */
+        return;
+    }
+
+    if (count > ACTUATOR_TELEMETRY_MAX_FRAMES) {
+        count = ACTUATOR_TELEMETRY_MAX_FRAMES;
+    }
+
+    ActuatorTelemetryFrame_t *p_buf  = p_tel->frames[p_tel->fill];
+    const uint16_t            length = (uint16_t)(count * sizeof(ActuatorTelemetryFrame_t));
+    for (uint8_t i = 0U; i < count; i++) {
+        fill_frame(&p_buf[i], &p_acts[i], i, sequence, current_time);
+    }
+
+    /* The DMA reads only the other buffer, so this one is safe to fill while
+       it runs; the transfer is started here, never from the ISR */
+    if (p_tel->tx_busy != 0U) {
+        p_tel->queued = length;
+    } else if (send_buffer(p_tel, p_buf, length) == 0U) {
+        return;
+    }
+    p_tel->fill     ^= 1U;                      /* Next sample goes to the other buffer */
+    p_tel->idle_sent = p_tel->idle;
+}
+
+void actuator_telemetry_set_idle(ActuatorTelemetry_t *p_tel, uint8_t idle, uint32_t current_time)
+{
+    if (p_tel == NULL) {
+        return;
+    }
+
+    if (idle == 0U) {
+        if (p_tel->idle != 0U) {
+            p_tel->next_time = current_time;    /* Motion resumed: report it now */
+        }
+        p_tel->idle_sent = 0U;
+    }
+    p_tel->idle = (idle != 0U) ? 1U : 0U;
+}
+
+uint8_t actuator_telemetry_tx_done(ActuatorTelemetry_t *p_tel)
+{
+    if (p_tel == NULL) {
+        return 0U;
+    }
+    p_tel->tx_busy = 0U;
+    return (p_tel->queued != 0U) ? 1U : 0U;
+}
+
+uint32_t actuator_telemetry_next_deadline(const ActuatorTelemetry_t *p_tel, uint32_t current_time)
+{
+    if ((p_tel == NULL) || (p_tel->period == 0U)) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+    if (p_tel->queued != 0U) {
+        /* Sent as soon as the transfer ahead of it is done (tx_done wakes the loop) */
+        return (p_tel->tx_busy == 0U) ? 0U : ACTUATOR_NO_DEADLINE;
+    }
+    if (p_tel->idle_sent != 0U) {
+        return ACTUATOR_NO_DEADLINE;
+    }
+
+    const uint32_t remaining = p_tel->next_time - current_time;
+    return ((int32_t)remaining <= 0) ? 0U : remaining;
+}
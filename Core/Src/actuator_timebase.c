@@ -0,0 +1,130 @@
+/**
+ * @file    actuator_timebase.c
+ * @brief   TIM4 (low) + TIM3 (high) microsecond clock, PB7/PB8 input capture.
+ */
+
+#include "actuator_timebase.h"
+
+#include "main.h"                   /* HAL, CMSIS */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/* Fixed by the pin map: TIM4_CH2 is PB7, TIM4_CH3 is PB8 */
+#define TIMEBASE_CAPTURE_GPIO_Port  GPIOB
+#define TIMEBASE_CH2_Pin            GPIO_PIN_7
+#define TIMEBASE_CH3_Pin            GPIO_PIN_8
+
+/* TIM3 trigger input ITR3 is TIM4 TRGO */
+#define TIMEBASE_TS_ITR3            (TIM_SMCR_TS_0 | TIM_SMCR_TS_1)
+
+/* Just below the limit-switch EXTI, above the command channel */
+#define TIMEBASE_IRQ_PRIORITY       1U
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/** Clock of the APB1 timers: PCLK1, doubled when APB1 is divided. */
+static uint32_t timebase_timer_clock(void)
+{
+    const uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1) ? pclk1 : (2U * pclk1);
+}
+
+/**
+ * @brief  Extend a 16-bit capture to 32 bits. The capture is at most one
+ *         low-half period old, so if the low half wrapped since, the high
+ *         half has counted once too often.
+ */
+static uint32_t timebase_extend(uint16_t captured)
+{
+    uint32_t high = TIM3->CNT;
+    uint16_t low  = (uint16_t)TIM4->CNT;
+
+    if (TIM3->CNT != high) {                    /* Wrapped between the reads */
+        high = TIM3->CNT;
+        low  = (uint16_t)TIM4->CNT;
+    }
+    if (captured > low) {
+        high--;
+    }
+    return ((high & 0xFFFFU) << 16U) | captured;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void actuator_timebase_init(void)
+{
+    __HAL_RCC_TIM3_CLK_ENABLE();
+    __HAL_RCC_TIM4_CLK_ENABLE();
+
+    /* ---- TIM3: high half, one count per TIM4 update ---- */
+    TIM3->CR1  = 0U;
+    TIM3->PSC  = 0U;
+    TIM3->ARR  = 0xFFFFU;
+    TIM3->SMCR = TIMEBASE_TS_ITR3 | TIM_SMCR_SMS;    /* External clock mode 1 */
+    TIM3->CNT  = 0U;
+    TIM3->CR1  = TIM_CR1_CEN;
+
+    /* ---- TIM4: low half at 1 MHz, update event on TRGO ---- */
+    TIM4->CR1   = 0U;
+    TIM4->PSC   = (uint16_t)((timebase_timer_clock() / ACTUATOR_TIMEBASE_HZ) - 1U);
+    TIM4->ARR   = 0xFFFFU;
+    TIM4->CR2   = TIM_CR2_MMS_1;
+    TIM4->EGR   = TIM_EGR_UG;                   /* Load PSC now */
+    TIM4->SR    = 0U;
+
+    /* ---- CH2 / CH3 capture TI2 / TI3, rising edge, no filter ---- */
+    TIM4->CCMR1 = TIM_CCMR1_CC2S_0;
+    TIM4->CCMR2 = TIM_CCMR2_CC3S_0;
+    TIM4->CCER  = TIM_CCER_CC2E | TIM_CCER_CC3E;
+    TIM4->DIER  = TIM_DIER_CC2IE | TIM_DIER_CC3IE;
+
+    TIM3->CNT   = 0U;                           /* The UG above clocked it once */
+    TIM4->CNT   = 0U;
+    TIM4->CR1   = TIM_CR1_CEN;
+
+    HAL_NVIC_SetPriority(TIM4_IRQn, TIMEBASE_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(TIM4_IRQn);
+}
+
+uint32_t actuator_timebase_now_us(void)
+{
+    uint32_t high = TIM3->CNT;
+    uint32_t low  = TIM4->CNT;
+    const uint32_t high2 = TIM3->CNT;
+
+    if (high2 != high) {                        /* Low half wrapped in between */
+        high = high2;
+        low  = TIM4->CNT;
+    }
+    return ((high & 0xFFFFU) << 16U) | (low & 0xFFFFU);
+}
+
+void actuator_timebase_irq_handler(void)
+{
+    const uint32_t sr = TIM4->SR;
+
+    /* Reading CCRx clears CCxIF */
+    if ((sr & TIM_SR_CC2IF) != 0U) {
+        actuator_timebase_capture_callback(TIMEBASE_CAPTURE_GPIO_Port, TIMEBASE_CH2_Pin,
+                                           timebase_extend((uint16_t)TIM4->CCR2));
+    }
+    if ((sr & TIM_SR_CC3IF) != 0U) {
+        actuator_timebase_capture_callback(TIMEBASE_CAPTURE_GPIO_Port, TIMEBASE_CH3_Pin,
+                                           timebase_extend((uint16_t)TIM4->CCR3));
+    }
+    TIM4->SR = ~(TIM_SR_CC2OF | TIM_SR_CC3OF);  /* Overcaptures: bounce, not needed */
+}
+
+__weak void actuator_timebase_capture_callback(void *port, uint16_t gpio_pin, uint32_t timestamp_us)
+{
+    (void)port;
+    (void)gpio_pin;
+    (void)timestamp_us;
+    /* Override in the application */
+}
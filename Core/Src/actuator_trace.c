@@ -0,0 +1,48 @@
+/**
+ * @file    actuator_trace.c
+ * @brief   State-transition trace ring, kept across a soft reset.
+ *
+ * Compiles to an empty translation unit unless ACTUATOR_TRACE_ENABLED.
+ */
+
+#include "actuator_trace.h"
+
+#if ACTUATOR_TRACE_ENABLED
+
+#include "stm32f1xx_hal.h"          /* HAL_GetTick */
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+/* Not zeroed by the startup code — see the .noinit section in the linker script */
+ActuatorTrace_t actuator_trace __attribute__((section(".noinit")));
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void actuator_trace_init(uint8_t reset_flags)
+{
+    if (actuator_trace.magic != ACTUATOR_TRACE_MAGIC) {
+        /* Power-on (RAM content is random) or first boot of this layout */
+        actuator_trace.head  = 0U;
+        actuator_trace.magic = ACTUATOR_TRACE_MAGIC;
+    }
+
+    actuator_trace_record(0xFFU, (uint8_t)ACTUATOR_TRACE_BOOT, reset_flags);
+}
+
+void actuator_trace_record(uint8_t actuator, uint8_t event, uint16_t arg)
+{
+    const uint32_t         head     = actuator_trace.head;
+    ActuatorTraceRecord_t *p_record = &actuator_trace.records[head & (ACTUATOR_TRACE_SIZE - 1U)];
+
+    p_record->tick     = HAL_GetTick();
+    p_record->event    = event;
+    p_record->actuator = actuator;
+    p_record->arg      = arg;
+    actuator_trace.head = head + 1U;
+}
+
+#endif /* ACTUATOR_TRACE_ENABLED */
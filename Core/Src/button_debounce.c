@@ -8,6 +8,9 @@
  * button_debounce_update() and are valid for one cycle only.
  */
 #include "button_debounce.h"
+#include "actuator_ramfunc.h"       /* Update in SRAM on the target */
+
+#include <stddef.h>                  /* NULL */
 
 /* -------------------------------------------------------------------------- */
 /*   Public API                                                               */
@@ -33,6 +36,7 @@ void button_debounce_init(ButtonDebounce_t *p_btn,
     p_btn->just_released   = 0U;
 }
 
+ACTUATOR_RAMFUNC
 void button_debounce_update(ButtonDebounce_t *p_btn,
                             uint8_t raw_state,
                             uint32_t current_time)
@@ -69,6 +73,29 @@ void button_debounce_update(ButtonDebounce_t *p_btn,
     }
 }
 
+ACTUATOR_RAMFUNC
+void button_debounce_set(ButtonDebounce_t *p_btn,
+                         uint8_t pressed,
+                         uint8_t raw_state,
+                         uint32_t current_time)
+{
+    if (p_btn == NULL) {
+        return;
+    }
+
+    /* ---- Raw level as sampled: an EXTI stop judges glitches from it ---- */
+    if (raw_state != p_btn->last_raw_state) {
+        p_btn->last_time      = current_time;
+        p_btn->last_raw_state = raw_state;
+    }
+    p_btn->stable_state = (pressed != 0U) ? p_btn->active_state : (uint8_t)(!p_btn->active_state);
+
+    p_btn->just_pressed  = ((pressed != 0U) && (p_btn->last_stable == 0U)) ? 1U : 0U;
+    p_btn->just_released = ((pressed == 0U) && (p_btn->last_stable != 0U)) ? 1U : 0U;
+    p_btn->last_stable   = (pressed != 0U) ? 1U : 0U;
+}
+
+ACTUATOR_RAMFUNC
 uint8_t button_debounce_is_pressed(const ButtonDebounce_t *p_btn)
 {
     if (p_btn == NULL) {
@@ -91,4 +118,94 @@ uint8_t button_debounce_just_released(const ButtonDebounce_t *p_btn)
         return 0U;
     }
     return p_btn->just_released;
-}
\ No newline at end of file
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Port-wide API                                                            */
+/* -------------------------------------------------------------------------- */
+
+void button_debounce_port_init(ButtonDebouncePort_t *p_port,
+                               uint16_t pin_mask,
+                               uint16_t active_high_mask,
+                               uint8_t samples)
+{
+    if (p_port == NULL) {
+        return;
+    }
+
+    if (samples == 0U) {
+        samples = 1U;
+    } else if (samples > BUTTON_DEBOUNCE_PORT_MAX_SAMPLES) {
+        samples = BUTTON_DEBOUNCE_PORT_MAX_SAMPLES;
+    }
+
+    p_port->pin_mask      = pin_mask;
+    p_port->invert_mask   = (uint16_t)(pin_mask & (uint16_t)~active_high_mask);
+    p_port->pressed       = 0U;
+    p_port->count0        = 0U;
+    p_port->count1        = 0U;
+    p_port->count2        = 0U;
+    p_port->just_pressed  = 0U;
+    p_port->just_released = 0U;
+
+    for (uint8_t bit = 0U; bit < 3U; bit++) {
+        p_port->samples_mask[bit] = ((samples & (1U << bit)) != 0U) ? 0xFFFFU : 0U;
+    }
+}
+
+ACTUATOR_RAMFUNC
+uint16_t button_debounce_port_update(ButtonDebouncePort_t *p_port, uint16_t idr)
+{
+    if (p_port == NULL) {
+        return 0U;
+    }
+
+    /* ---- Pins whose raw level disagrees with the stable state ---- */
+    const uint16_t raw   = (uint16_t)((idr ^ p_port->invert_mask) & p_port->pin_mask);
+    const uint16_t delta = (uint16_t)(raw ^ p_port->pressed);
+
+    /* ---- Increment the counters of disagreeing pins, clear the others ---- */
+    const uint16_t c0 = (uint16_t)(~p_port->count0 & delta);
+    const uint16_t c1 = (uint16_t)((p_port->count1 ^ p_port->count0) & delta);
+    const uint16_t c2 = (uint16_t)((p_port->count2 ^ (p_port->count1 & p_port->count0)) & delta);
+
+    /* ---- Toggle where the counter reached `samples` ---- */
+    const uint16_t toggle = (uint16_t)(delta &
+                                       ~(c0 ^ p_port->samples_mask[0]) &
+                                       ~(c1 ^ p_port->samples_mask[1]) &
+                                       ~(c2 ^ p_port->samples_mask[2]));
+
+    p_port->count0  = (uint16_t)(c0 & ~toggle);
+    p_port->count1  = (uint16_t)(c1 & ~toggle);
+    p_port->count2  = (uint16_t)(c2 & ~toggle);
+    p_port->pressed = (uint16_t)(p_port->pressed ^ toggle);
+
+    p_port->just_pressed  = (uint16_t)(toggle & p_port->pressed);
+    p_port->just_released = (uint16_t)(toggle & ~p_port->pressed);
+
+    return p_port->pressed;
+}
+
+uint16_t button_debounce_port_pressed(const ButtonDebouncePort_t *p_port)
+{
+    if (p_port == NULL) {
+        return 0U;
+    }
+    return p_port->pressed;
+}
+
+uint16_t button_debounce_port_just_pressed(const ButtonDebouncePort_t *p_port)
+{
+    if (p_port == NULL) {
+        return 0U;
+    }
+    return p_port->just_pressed;
+}
+
+uint16_t button_debounce_port_just_released(const ButtonDebouncePort_t *p_port)
+{
+    if (p_port == NULL) {
+        return 0U;
+    }
+    return p_port->just_released;
+}
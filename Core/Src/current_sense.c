@@ -0,0 +1,112 @@
+/**
+ * @file    current_sense.c
+ * @brief   ADC1 channel 4 (PA4) continuous conversion into a DMA1 channel 1 ring.
+ */
+
+#include "current_sense.h"
+
+#include "main.h"                   /* HAL, CMSIS */
+#include "actuator_ramfunc.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+#define CURRENT_SENSE_Pin           GPIO_PIN_4
+#define CURRENT_SENSE_GPIO_Port     GPIOA
+#define CURRENT_SENSE_CHANNEL       4U
+
+/* SMPx = 111: 239.5 cycles — the shunt amplifier is a slow source */
+#define CURRENT_SENSE_SMP4          ADC_SMPR2_SMP4
+
+/* EXTSEL = 111: conversions started by SWSTART */
+#define CURRENT_SENSE_EXTSEL        ADC_CR2_EXTSEL
+
+/* Same level as the limit-switch EXTI: a stall stops the motor as fast */
+#define CURRENT_SENSE_IRQ_PRIORITY  0U
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static volatile uint16_t s_ring[CURRENT_SENSE_RING_SIZE];
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void current_sense_init(void)
+{
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    __HAL_RCC_ADC_CONFIG(RCC_ADCPCLK2_DIV6);    /* 72 MHz / 6 = 12 MHz (max 14) */
+
+    /* ---- PA4 analog ---- */
+    gpio.Pin  = CURRENT_SENSE_Pin;
+    gpio.Mode = GPIO_MODE_ANALOG;
+    HAL_GPIO_Init(CURRENT_SENSE_GPIO_Port, &gpio);
+
+    /* ---- DMA1 channel 1 = ADC1, circular, half-word, half and full interrupts ---- */
+    DMA1_Channel1->CCR   = 0U;
+    DMA1->IFCR           = DMA_IFCR_CGIF1;
+    DMA1_Channel1->CPAR  = (uint32_t)&ADC1->DR;
+    DMA1_Channel1->CMAR  = (uint32_t)s_ring;
+    DMA1_Channel1->CNDTR = CURRENT_SENSE_RING_SIZE;
+    DMA1_Channel1->CCR   = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 |
+                           DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+
+    /* ---- ADC1: one regular channel, continuous, results through DMA ---- */
+    ADC1->CR1   = 0U;
+    ADC1->SMPR2 = CURRENT_SENSE_SMP4;
+    ADC1->SQR1  = 0U;                           /* L = 0: one conversion */
+    ADC1->SQR3  = CURRENT_SENSE_CHANNEL;
+    ADC1->CR2   = ADC_CR2_ADON;                 /* Power up, then wait t_STAB (1 us) */
+    for (volatile uint32_t i = 0U; i < (SystemCoreClock / 1000000U); i++) {
+    }
+
+    ADC1->CR2 |= ADC_CR2_RSTCAL;
+    while ((ADC1->CR2 & ADC_CR2_RSTCAL) != 0U) {
+    }
+    ADC1->CR2 |= ADC_CR2_CAL;
+    while ((ADC1->CR2 & ADC_CR2_CAL) != 0U) {
+    }
+
+    HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, CURRENT_SENSE_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    ADC1->CR2 = ADC_CR2_ADON | ADC_CR2_CONT | ADC_CR2_DMA |
+                CURRENT_SENSE_EXTSEL | ADC_CR2_EXTTRIG;
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+}
+
+const volatile uint16_t *current_sense_buffer(void)
+{
+    return s_ring;
+}
+
+ACTUATOR_RAMFUNC
+uint16_t current_sense_position(void)
+{
+    /* CNDTR counts down from RING_SIZE and reloads in circular mode */
+    const uint16_t remaining = (uint16_t)DMA1_Channel1->CNDTR;
+    return (uint16_t)((CURRENT_SENSE_RING_SIZE - remaining) & (CURRENT_SENSE_RING_SIZE - 1U));
+}
+
+ACTUATOR_RAMFUNC
+void current_sense_irq_handler(void)
+{
+    const uint32_t isr = DMA1->ISR;
+
+    DMA1->IFCR = DMA_IFCR_CGIF1;                /* Clears HT, TC and TE of channel 1 */
+    if ((isr & (DMA_ISR_HTIF1 | DMA_ISR_TCIF1)) != 0U) {
+        current_sense_block_callback();
+    }
+}
+
+__weak void current_sense_block_callback(void)
+{
+    /* Override in the application */
+}
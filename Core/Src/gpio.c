@@ -70,4 +70,21 @@ void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 2 */
 
+/**
+  * @brief  Switch the limit-switch inputs to EXTI on both edges.
+  * @note   Called after MX_GPIO_Init(). Both pins share EXTI9_5.
+  */
+void MX_GPIO_LimitSwitchExti_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  GPIO_InitStruct.Pin = EXTEND_SWITCH_Pin|SHRINK_SWITCH_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+  HAL_NVIC_SetPriority(EXTI9_5_IRQn, LIMIT_SWITCH_EXTI_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+}
+
 /* USER CODE END 2 */
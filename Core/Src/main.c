@@ -22,7 +22,20 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "actuator_bridge.h"
+#include "actuator_command.h"
 #include "actuator_control.h"
+#include "actuator_encoder.h"
+#include "actuator_current.h"
+#include "actuator_group.h"
+#include "actuator_profile.h"
+#include "actuator_ramfunc.h"
+#include "actuator_storage.h"
+#include "actuator_telemetry.h"
+#include "actuator_timebase.h"
+#include "actuator_trace.h"
+#include "current_sense.h"
+#include "uart_command.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -33,6 +46,12 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 
+/* Enter STOP mode (instead of SLEEP) while the actuator has no deadline */
+#define LOW_POWER_STOP_ENABLED  1U
+
+/* Actuators on this board (entries of actuator_configs[]) */
+#define ACTUATOR_COUNT          1U
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -43,14 +62,32 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-static ActuatorControl_t s_actuator_control;   /* Actuator state — file-scoped */
-static uint32_t          s_last_update_tick;    /* Last tick the loop ran at   */
+static ActuatorGroup_t   s_actuators;          /* All actuators — file-scoped */
+static ActuatorControl_t *s_p_actuator;        /* Actuator 0, the one with a stored calibration */
+static ActuatorStorage_t s_actuator_storage;   /* Calibration record in flash */
+static uint32_t          s_next_update_tick;    /* Tick at which the next update is due */
+static uint8_t           s_deadline_armed;      /* Non-zero if s_next_update_tick is valid */
+static volatile uint8_t  s_wake_event;          /* Set by ISRs that need an update now  */
+#if UART_COMMAND_ENABLED
+static CommandParser_t   s_command_parser;      /* Decodes lines in place in the DMA ring (USART1 ISR) */
+static ActuatorTelemetry_t s_telemetry;         /* Ping-pong frame buffers read by USART1 TX DMA */
+#endif
+#if CURRENT_SENSE_ENABLED
+static ActuatorCurrent_t s_current;             /* Stall detector over the ADC1 DMA ring */
+#endif
 static const uint32_t    LOOP_COOLDOWN_MS = 1U; /* Minimum period between iterations */
+#if ACTUATOR_PROFILE_ENABLED
+volatile uint8_t         profile_dump_request;  /* Set from the debugger to print stats on SWO */
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
+static void app_sleep(void);
+#if ACTUATOR_PROFILE_ENABLED
+static void profile_write_swo(const char *p_text, uint16_t length);
+#endif
 
 /* USER CODE END PFP */
 
@@ -90,16 +127,69 @@ int main(void)
   MX_GPIO_Init();
   /* USER CODE BEGIN 2 */
 
-  /* ---- Initialise actuator ---- */
-  const ActuatorConfig_t actuator_config = {
+#if ACTUATOR_TRACE_ENABLED
+  /* Keep the pre-reset history and log why we came back up */
+  actuator_trace_init((uint8_t)(RCC->CSR >> 24));
+  __HAL_RCC_CLEAR_RESET_FLAGS();
+#endif
+
+#if ACTUATOR_PROFILE_ENABLED
+  actuator_profile_init();
+#endif
+
+#if ACTUATOR_TIMEBASE_ENABLED
+  actuator_timebase_init();
+#endif
+
+#if ACTUATOR_ENCODER_ENABLED
+  actuator_encoder_init(ACTUATOR_ENCODER_INVERTED);
+#endif
+
+#if ACTUATOR_BRIDGE_ENABLED
+  actuator_bridge_init(ACTUATOR_BRIDGE_ACCEL_MS, ACTUATOR_BRIDGE_DECEL_MS, ACTUATOR_BRIDGE_APPROACH_PCT);
+#endif
+
+  /* ---- Initialise actuators (one entry per actuator on the board) ---- */
+  const ActuatorConfig_t actuator_configs[ACTUATOR_COUNT] = {
+    {
       .extend_active_level = GPIO_PIN_SET,
       .shrink_active_level = GPIO_PIN_SET,
       .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+      .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+      .homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT,
+#if ACTUATOR_BRIDGE_ENABLED
+      /* A reversal waits for the ramp to rest; a soft stop from full
+         speed travels as far as half the ramp at full speed, a soft
+         start falls behind by as much */
+      .relay_dead_time_ms  = MS_TO_TICKS(ACTUATOR_BRIDGE_DECEL_MS),
+      .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_BRIDGE_DECEL_MS / 2U),
+      .start_lag_ms        = MS_TO_TICKS(ACTUATOR_BRIDGE_ACCEL_MS / 2U),
+      .approach_permille   = ACTUATOR_APPROACH_PERMILLE,
+#else
+      .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+      .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+#endif
+      .park_position       = ACTUATOR_PARK_POSITION,
+      .stall_end_stop      = CURRENT_STALL_END_STOP,
+      .switch_edge_wakeup  = LIMIT_SWITCH_EXTI_ENABLED,
+#if ACTUATOR_TIMEBASE_ENABLED
+      .timestamp_us        = actuator_timebase_now_us,
+#endif
+#if ACTUATOR_ENCODER_ENABLED
+      .encoder_count       = actuator_encoder_count,
+#endif
+#if ACTUATOR_BRIDGE_ENABLED
+      .bridge_output       = actuator_bridge_output,
+
+      .extend_control_port = NULL,              /* No relays: PA8 / PA11 drive the bridge */
+      .shrink_control_port = NULL,
+#else
 
       .extend_control_port = (void*)GPIOB,
       .extend_control_pin  = EXTEND_CNTR_Pin,
       .shrink_control_port = (void*)GPIOB,
       .shrink_control_pin  = SHRINK_CNTR_Pin,
+#endif
       .extend_switch_port  = (void*)GPIOB,
       .extend_switch_pin   = EXTEND_SWITCH_Pin,
       .shrink_switch_port  = (void*)GPIOB,
@@ -108,12 +198,42 @@ int main(void)
       .led_extend_pin      = LED_EXTEND_Pin,
       .led_shrink_port     = (void*)GPIOB,
       .led_shrink_pin      = LED_SHRINK_Pin
+    }
   };
 
-  actuator_init(&s_actuator_control, &actuator_config);
-  actuator_start_homing(&s_actuator_control);
+  (void)actuator_group_init(&s_actuators, actuator_configs, ACTUATOR_COUNT);
+  s_p_actuator = actuator_group_get(&s_actuators, 0U);
 
-  s_last_update_tick = HAL_GetTick();
+#if LIMIT_SWITCH_EXTI_ENABLED
+  MX_GPIO_LimitSwitchExti_Init();
+#endif
+
+#if CURRENT_SENSE_ENABLED
+  const ActuatorCurrentConfig_t current_config = {
+    .threshold    = CURRENT_STALL_THRESHOLD,
+    .blank_blocks = CURRENT_SENSE_MS_TO_BLOCKS(CURRENT_STALL_BLANK_MS),
+    .stall_blocks = CURRENT_SENSE_MS_TO_BLOCKS(CURRENT_STALL_TIME_MS),
+    .block_shift  = CURRENT_SENSE_BLOCK_SHIFT
+  };
+  (void)actuator_current_init(&s_current, current_sense_buffer(), CURRENT_SENSE_RING_SIZE,
+                              &current_config);
+  current_sense_init();
+#endif
+
+#if UART_COMMAND_ENABLED
+  (void)command_parser_init(&s_command_parser, uart_command_rx_buffer(), UART_COMMAND_RX_SIZE);
+  uart_command_init();
+  actuator_telemetry_init(&s_telemetry, MS_TO_TICKS(UART_TELEMETRY_PERIOD_MS),
+                          uart_command_transmit, HAL_GetTick());
+#endif
+
+  /* Resume from the stored calibration; home only if it is missing or stale */
+  if (actuator_storage_load(&s_actuator_storage, s_p_actuator) != ACTUATOR_STORAGE_OK) {
+      actuator_start_homing(s_p_actuator);
+  }
+
+  s_next_update_tick = HAL_GetTick();
+  s_deadline_armed   = 1U;
 
   /* USER CODE END 2 */
 
@@ -123,24 +243,55 @@ int main(void)
   {
     const uint32_t current_time = HAL_GetTick();
 
-    /* Run the state machine at LOOP_COOLDOWN_MS intervals */
-    if ((current_time - s_last_update_tick) >= LOOP_COOLDOWN_MS) {
-        s_last_update_tick = current_time;
-
-        actuator_update(&s_actuator_control, current_time);
-
-        if (actuator_get_state(&s_actuator_control) == ACTUATOR_IDLE &&
-            !actuator_is_homing(&s_actuator_control))
+    /* Run the state machine when its deadline is due or an ISR asked for it */
+    if ((s_wake_event != 0U) ||
+        ((s_deadline_armed != 0U) && ((int32_t)(current_time - s_next_update_tick) >= 0))) {
+        s_wake_event = 0U;
+
+        ACTUATOR_PROFILE_START(pass_start, ACTUATOR_PROFILE_LOOP_PASS);
+        actuator_group_update(&s_actuators, current_time);
+        const uint8_t group_idle = actuator_group_is_idle(&s_actuators);
+#if UART_COMMAND_ENABLED
+        actuator_telemetry_set_idle(&s_telemetry, group_idle, current_time);
+        actuator_telemetry_update(&s_telemetry, s_actuators.actuators,
+                                  s_actuators.actuator_count, current_time);
+#endif
+        actuator_storage_service(&s_actuator_storage, s_p_actuator, group_idle, current_time);
+
+        if (actuator_get_state(s_p_actuator) == ACTUATOR_IDLE &&
+            !actuator_is_homing(s_p_actuator))
         {
             /* Actuator is idle and homing is complete — ready for commands */
         }
-        else if (actuator_is_error(&s_actuator_control))
+        else if (actuator_is_error(s_p_actuator))
         {
             /* An error has occurred (e.g. homing timeout) */
         }
+
+        uint32_t delay = actuator_group_next_deadline(&s_actuators, current_time);
+#if UART_COMMAND_ENABLED
+        const uint32_t telemetry_delay = actuator_telemetry_next_deadline(&s_telemetry, current_time);
+        delay = (telemetry_delay < delay) ? telemetry_delay : delay;
+#endif
+        const uint32_t storage_delay = actuator_storage_next_deadline(&s_actuator_storage, s_p_actuator,
+                                                                      group_idle, current_time);
+        delay = (storage_delay < delay) ? storage_delay : delay;
+
+        s_deadline_armed   = (delay != ACTUATOR_NO_DEADLINE) ? 1U : 0U;
+        s_next_update_tick = current_time + ((delay < LOOP_COOLDOWN_MS) ? LOOP_COOLDOWN_MS : delay);
+
+        ACTUATOR_PROFILE_STOP(pass_start);
     }
 
-    /* No blocking delay — the loop spins freely for maximum responsiveness */
+#if ACTUATOR_PROFILE_ENABLED
+    if (profile_dump_request != 0U) {
+        profile_dump_request = 0U;
+        actuator_profile_dump(profile_write_swo);
+    }
+#endif
+
+    /* Sleep until the next SysTick / EXTI — or in STOP mode if nothing is due */
+    app_sleep();
 
     /* USER CODE END WHILE */
 
@@ -190,6 +341,137 @@ void SystemClock_Config(void)
 
 /* USER CODE BEGIN 4 */
 
+/**
+  * @brief  EXTI callback — forwards limit-switch edges to the actuators.
+  * @param  GPIO_Pin  Pin that triggered the interrupt.
+  */
+ACTUATOR_RAMFUNC
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  actuator_group_limit_switch_isr(&s_actuators, GPIO_Pin);
+  s_wake_event = 1U;
+}
+
+#if UART_COMMAND_ENABLED
+/**
+  * @brief  USART1 idle line — a burst of command bytes has landed in the ring.
+  * @note   Decodes every complete line and posts it to the actuator's queue;
+  *         actuator_update() issues it at the start of the next pass. The
+  *         scan is bounded by the ring size. Commands for an unknown index
+  *         or a full queue are dropped.
+  */
+void uart_command_idle_callback(void)
+{
+  ActuatorCommand_t command;
+
+  while (command_parser_next(&s_command_parser, uart_command_rx_position(), &command) != 0U) {
+    if ((command.type != ACTUATOR_CMD_NONE) && (command.type != ACTUATOR_CMD_INVALID)) {
+      (void)actuator_group_post(&s_actuators, &command);
+    }
+  }
+  s_wake_event = 1U;
+}
+
+/**
+  * @brief  USART1 TX DMA done — the telemetry buffer it read is free again;
+  *         wake the loop to send the buffer queued behind it.
+  */
+void uart_command_tx_done_callback(void)
+{
+  if (actuator_telemetry_tx_done(&s_telemetry) != 0U) {
+    s_wake_event = 1U;
+  }
+}
+#endif
+
+#if ACTUATOR_TIMEBASE_ENABLED
+/**
+  * @brief  TIM4 captured a limit-switch edge — timestamp for the travel time.
+  */
+void actuator_timebase_capture_callback(void *port, uint16_t gpio_pin, uint32_t timestamp_us)
+{
+  actuator_group_switch_edge(&s_actuators, port, gpio_pin, timestamp_us);
+}
+#endif
+
+#if CURRENT_SENSE_ENABLED
+/**
+  * @brief  DMA filled half the current ring — check the new samples for a stall.
+  * @note   Runs every 1.3 ms. The drive is taken from the selected output, so
+  *         each start or reversal reopens the inrush blanking window.
+  */
+ACTUATOR_RAMFUNC
+void current_sense_block_callback(void)
+{
+  actuator_current_set_running(&s_current, (uint8_t)s_p_actuator->output);
+  if (actuator_current_process(&s_current, current_sense_position()) != 0U) {
+    actuator_stall_isr(s_p_actuator);
+    s_wake_event = 1U;
+  }
+}
+#endif
+
+/**
+  * @brief  Sleep until the next interrupt.
+  * @note   Interrupts are masked while deciding, so an event raised just
+  *         before WFI still wakes the core (WFI returns on a pending IRQ
+  *         even with PRIMASK set) and its ISR runs right after wake-up.
+  *         SysTick is stopped in STOP mode, so STOP is only used while no
+  *         deadline is armed; the clock tree is restored on wake-up, with
+  *         interrupts and SysTick running so that a failed HSE or PLL start
+  *         times out into Error_Handler().
+  *         USART1 is clocked off in STOP: PA10 is armed as an EXTI wake-up
+  *         line instead, and the receiver and the parser restart on wake-up
+  *         (the first bytes of the waking burst are lost). STOP waits for a
+  *         telemetry frame still on the wire. The ADC stops as well, so
+  *         STOP is not used with current sensing either — the motor may run
+  *         with no deadline armed. Nor with the H-bridge: TIM1 would freeze
+  *         a soft stop at its current duty.
+  */
+static void app_sleep(void)
+{
+  __disable_irq();
+
+  if (s_wake_event == 0U) {
+#if LOW_POWER_STOP_ENABLED && !CURRENT_SENSE_ENABLED && !ACTUATOR_BRIDGE_ENABLED
+#if UART_COMMAND_ENABLED
+    if ((s_deadline_armed == 0U) && (uart_command_prepare_stop() != 0U)) {
+#else
+    if (s_deadline_armed == 0U) {
+#endif
+      HAL_SuspendTick();
+      HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+      __enable_irq();                   /* The RCC timeouts count SysTick */
+      HAL_ResumeTick();
+      SystemClock_Config();             /* STOP leaves the core on HSI */
+#if UART_COMMAND_ENABLED
+      __disable_irq();                  /* No USART1 IRQ before the parser restarts */
+      uart_command_resume();
+      (void)command_parser_init(&s_command_parser, uart_command_rx_buffer(), UART_COMMAND_RX_SIZE);
+#endif
+    } else
+#endif
+    {
+      HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    }
+  }
+
+  __enable_irq();
+}
+
+#if ACTUATOR_PROFILE_ENABLED
+/**
+  * @brief  Profile dump sink — SWO (ITM stimulus port 0), readable with the
+  *         CubeIDE SWV console. Nothing is sent if no debugger enabled ITM.
+  */
+static void profile_write_swo(const char *p_text, uint16_t length)
+{
+  for (uint16_t i = 0U; i < length; i++) {
+      (void)ITM_SendChar((uint32_t)p_text[i]);
+  }
+}
+#endif
+
 /* USER CODE END 4 */
 
 /**
@@ -22,6 +22,12 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "actuator_bridge.h"
+#include "actuator_encoder.h"
+#include "actuator_ramfunc.h"
+#include "actuator_timebase.h"
+#include "current_sense.h"
+#include "uart_command.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -46,6 +52,13 @@
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN PFP */
+/* Handlers of the control loop run from SRAM; the attribute on these
+   declarations carries over to the generated definitions below */
+ACTUATOR_RAMFUNC void SysTick_Handler(void);
+ACTUATOR_RAMFUNC void HAL_IncTick(void);
+ACTUATOR_RAMFUNC void EXTI9_5_IRQHandler(void);
+ACTUATOR_RAMFUNC void DMA1_Channel1_IRQHandler(void);
+ACTUATOR_RAMFUNC void TIM1_UP_IRQHandler(void);
 
 /* USER CODE END PFP */
 
@@ -199,5 +212,86 @@ void SysTick_Handler(void)
 /******************************************************************************/
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief Tick counter for HAL_GetTick(); overrides the __weak HAL version,
+  *        which is linked into flash, so that SysTick stays in SRAM.
+  */
+void HAL_IncTick(void)
+{
+  uwTick += (uint32_t)uwTickFreq;
+}
+
+/**
+  * @brief This function handles EXTI line[9:5] interrupts (limit switches).
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  /* Test and clear EXTI->PR here — HAL_GPIO_EXTI_IRQHandler() is in flash */
+  const uint32_t pending = EXTI->PR & (uint32_t)(EXTEND_SWITCH_Pin | SHRINK_SWITCH_Pin);
+
+  EXTI->PR = pending;                   /* Write 1 to clear */
+  if ((pending & EXTEND_SWITCH_Pin) != 0U) {
+    HAL_GPIO_EXTI_Callback(EXTEND_SWITCH_Pin);
+  }
+  if ((pending & SHRINK_SWITCH_Pin) != 0U) {
+    HAL_GPIO_EXTI_Callback(SHRINK_SWITCH_Pin);
+  }
+}
+
+/**
+  * @brief This function handles EXTI line[15:10] interrupts (PA10 STOP wake-up).
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  uart_command_wake_irq_handler();
+}
+
+/**
+  * @brief This function handles TIM1 update interrupt (H-bridge ramp step).
+  */
+void TIM1_UP_IRQHandler(void)
+{
+  actuator_bridge_irq_handler();
+}
+
+/**
+  * @brief This function handles TIM2 global interrupt (encoder counter wrap).
+  */
+void TIM2_IRQHandler(void)
+{
+  actuator_encoder_irq_handler();
+}
+
+/**
+  * @brief This function handles TIM4 global interrupt (limit-switch edge capture).
+  */
+void TIM4_IRQHandler(void)
+{
+  actuator_timebase_irq_handler();
+}
+
+/**
+  * @brief This function handles DMA1 channel1 global interrupt (ADC1 motor current ring).
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  current_sense_irq_handler();
+}
+
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (USART1 TX, telemetry).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+  uart_command_tx_irq_handler();
+}
+
+/**
+  * @brief This function handles USART1 global interrupt (command channel idle line).
+  */
+void USART1_IRQHandler(void)
+{
+  uart_command_irq_handler();
+}
 
 /* USER CODE END 1 */
@@ -0,0 +1,210 @@
+/**
+ * @file    uart_command.c
+ * @brief   USART1 command channel: circular DMA receive with idle-line wake-up,
+ *          DMA transmit for telemetry.
+ */
+
+#include "uart_command.h"
+
+#include "main.h"                   /* HAL, pin map */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+#define UART_COMMAND_TX_Pin         GPIO_PIN_9
+#define UART_COMMAND_RX_Pin         GPIO_PIN_10
+#define UART_COMMAND_GPIO_Port      GPIOA
+
+/* Below the limit-switch EXTI: a stop must never wait for a command byte */
+#define UART_COMMAND_IRQ_PRIORITY   2U
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static volatile uint8_t  s_rx_buffer[UART_COMMAND_RX_SIZE];
+static DMA_HandleTypeDef s_hdma_usart1_rx;
+static DMA_HandleTypeDef s_hdma_usart1_tx;
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/** Transfer complete or failed — the buffer is free again. */
+static void tx_complete(DMA_HandleTypeDef *p_hdma)
+{
+    (void)p_hdma;
+    uart_command_tx_done_callback();
+}
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void uart_command_init(void)
+{
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_AFIO_CLK_ENABLE();
+    __HAL_RCC_USART1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* ---- PA9 TX (alternate push-pull), PA10 RX (input, pulled up when idle) ---- */
+    gpio.Pin   = UART_COMMAND_TX_Pin;
+    gpio.Mode  = GPIO_MODE_AF_PP;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(UART_COMMAND_GPIO_Port, &gpio);
+
+    gpio.Pin   = UART_COMMAND_RX_Pin;
+    gpio.Mode  = GPIO_MODE_INPUT;
+    gpio.Pull  = GPIO_PULLUP;
+    HAL_GPIO_Init(UART_COMMAND_GPIO_Port, &gpio);
+
+    /* ---- DMA1 channel 5 = USART1_RX, circular, byte to byte ---- */
+    s_hdma_usart1_rx.Instance                 = DMA1_Channel5;
+    s_hdma_usart1_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    s_hdma_usart1_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+    s_hdma_usart1_rx.Init.MemInc              = DMA_MINC_ENABLE;
+    s_hdma_usart1_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    s_hdma_usart1_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    s_hdma_usart1_rx.Init.Mode                = DMA_CIRCULAR;
+    s_hdma_usart1_rx.Init.Priority            = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&s_hdma_usart1_rx) != HAL_OK) {
+        Error_Handler();
+    }
+
+    /* ---- DMA1 channel 4 = USART1_TX, one buffer per transfer ---- */
+    s_hdma_usart1_tx.Instance                 = DMA1_Channel4;
+    s_hdma_usart1_tx.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    s_hdma_usart1_tx.Init.PeriphInc           = DMA_PINC_DISABLE;
+    s_hdma_usart1_tx.Init.MemInc              = DMA_MINC_ENABLE;
+    s_hdma_usart1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    s_hdma_usart1_tx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    s_hdma_usart1_tx.Init.Mode                = DMA_NORMAL;
+    s_hdma_usart1_tx.Init.Priority            = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&s_hdma_usart1_tx) != HAL_OK) {
+        Error_Handler();
+    }
+    s_hdma_usart1_tx.XferCpltCallback  = tx_complete;
+    s_hdma_usart1_tx.XferErrorCallback = tx_complete;   /* Release the buffer either way */
+
+    /* ---- USART1: 8N1, RX and TX through DMA, interrupt on idle line only ---- */
+    USART1->CR1 = 0U;
+    USART1->CR2 = 0U;
+    USART1->CR3 = USART_CR3_DMAR | USART_CR3_DMAT;
+    USART1->BRR = (HAL_RCC_GetPCLK2Freq() + (UART_COMMAND_BAUDRATE / 2U)) / UART_COMMAND_BAUDRATE;
+
+    if (HAL_DMA_Start(&s_hdma_usart1_rx, (uint32_t)&USART1->DR,
+                      (uint32_t)s_rx_buffer, UART_COMMAND_RX_SIZE) != HAL_OK) {
+        Error_Handler();
+    }
+
+    USART1->CR1 = USART_CR1_UE | USART_CR1_TE | USART_CR1_RE | USART_CR1_IDLEIE;
+
+    HAL_NVIC_SetPriority(USART1_IRQn, UART_COMMAND_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, UART_COMMAND_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+    /* ---- EXTI10 from PA10: STOP-mode wake-up, masked until armed ---- */
+    AFIO->EXTICR[2] &= ~AFIO_EXTICR3_EXTI10;
+    EXTI->IMR       &= ~(uint32_t)UART_COMMAND_RX_Pin;
+    EXTI->FTSR      |= UART_COMMAND_RX_Pin;
+    HAL_NVIC_SetPriority(EXTI15_10_IRQn, UART_COMMAND_IRQ_PRIORITY, 0U);
+    HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+}
+
+uint8_t uart_command_prepare_stop(void)
+{
+    /* A frame still on the wire would be cut mid-byte */
+    if ((HAL_DMA_GetState(&s_hdma_usart1_tx) != HAL_DMA_STATE_READY) ||
+        ((USART1->SR & USART_SR_TC) == 0U)) {
+        return 0U;
+    }
+
+    /* Held off until resume: the receiver reads garbage while clocks restart */
+    HAL_NVIC_DisableIRQ(USART1_IRQn);
+    EXTI->PR   = UART_COMMAND_RX_Pin;
+    EXTI->IMR |= UART_COMMAND_RX_Pin;
+    return 1U;
+}
+
+void uart_command_resume(void)
+{
+    EXTI->IMR &= ~(uint32_t)UART_COMMAND_RX_Pin;
+    EXTI->PR   = UART_COMMAND_RX_Pin;
+
+    /* ---- Receiver off, ring restarted at offset 0 ---- */
+    USART1->CR1 &= ~USART_CR1_RE;
+    (void)HAL_DMA_Abort(&s_hdma_usart1_rx);
+    (void)USART1->SR;                               /* SR then DR clears stale flags */
+    (void)USART1->DR;
+
+    USART1->BRR = (HAL_RCC_GetPCLK2Freq() + (UART_COMMAND_BAUDRATE / 2U)) / UART_COMMAND_BAUDRATE;
+    if (HAL_DMA_Start(&s_hdma_usart1_rx, (uint32_t)&USART1->DR,
+                      (uint32_t)s_rx_buffer, UART_COMMAND_RX_SIZE) != HAL_OK) {
+        Error_Handler();
+    }
+    USART1->CR1 |= USART_CR1_RE;
+    HAL_NVIC_ClearPendingIRQ(USART1_IRQn);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void uart_command_wake_irq_handler(void)
+{
+    /* The wake-up itself was the point; the USART takes over after resume */
+    EXTI->IMR &= ~(uint32_t)UART_COMMAND_RX_Pin;
+    EXTI->PR   = UART_COMMAND_RX_Pin;
+}
+
+uint8_t uart_command_transmit(const uint8_t *p_data, uint16_t length)
+{
+    /* No half-transfer callback, so HAL enables complete and error only */
+    if (HAL_DMA_Start_IT(&s_hdma_usart1_tx, (uint32_t)p_data,
+                         (uint32_t)&USART1->DR, length) != HAL_OK) {
+        return 0U;
+    }
+    return 1U;
+}
+
+void uart_command_tx_irq_handler(void)
+{
+    HAL_DMA_IRQHandler(&s_hdma_usart1_tx);
+}
+
+const volatile uint8_t *uart_command_rx_buffer(void)
+{
+    return s_rx_buffer;
+}
+
+uint16_t uart_command_rx_position(void)
+{
+    /* CNDTR counts down from RX_SIZE and reloads in circular mode */
+    const uint16_t remaining = (uint16_t)__HAL_DMA_GET_COUNTER(&s_hdma_usart1_rx);
+    return (uint16_t)((UART_COMMAND_RX_SIZE - remaining) & (UART_COMMAND_RX_SIZE - 1U));
+}
+
+void uart_command_irq_handler(void)
+{
+    const uint32_t sr = USART1->SR;
+
+    if ((sr & (USART_SR_IDLE | USART_SR_ORE | USART_SR_NE | USART_SR_FE)) != 0U) {
+        /* SR then DR read clears IDLE and the error flags; DMA already took the data */
+        (void)USART1->DR;
+    }
+    if ((sr & USART_SR_IDLE) != 0U) {
+        uart_command_idle_callback();
+    }
+}
+
+__weak void uart_command_tx_done_callback(void)
+{
+    /* Override in the application */
+}
+
+__weak void uart_command_idle_callback(void)
+{
+    /* Override in the application */
+}
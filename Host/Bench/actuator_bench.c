@@ -0,0 +1,386 @@
+/**
+ * @file    actuator_bench.c
+ * @brief   Host microbenchmark for actuator_update().
+ *
+ * Measures the average cost of one actuator_update() call in every
+ * ActuatorState_t and every HomingPhase_t, and the cost of debouncing a full
+ * 16-pin port with 16 ButtonDebounce_t instances versus one
+ * ButtonDebouncePort_t, and of four actuators updated one by one versus as
+ * one ActuatorGroup_t, and of a telemetry sample of four actuators. The
+ * EXTENDING run is repeated through the C++ front end (actuator.hpp, see
+ * actuator_bench_template.cpp). Each scenario is prepared so that
+ * the state machine stays in the measured state for the whole run (no switch
+ * is pressed, the homing timeout and the midpoint move never expire).
+ *
+ * `actuator_bench_hal` is the same program built against a core compiled
+ * with `ACTUATOR_GPIO_LL=0`, for comparing the two GPIO drivers.
+ *
+ * Usage:  actuator_bench [iterations]
+ *
+ * Output is one line per scenario: `<scenario> <ns/call>`, best of
+ * #BENCH_REPEATS runs, so that it can be diffed between commits.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "actuator_control.h"
+#include "actuator_gpio.h"          /* ACTUATOR_GPIO_LL */
+#include "actuator_group.h"
+#include "actuator_telemetry.h"
+#include "main.h"                   /* Board pin map (EXTEND_CNTR_Pin, ...) */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+#define BENCH_DEFAULT_ITERATIONS    10000000UL
+#define BENCH_REPEATS               5U
+
+/**
+ * @brief  Tick values cycle inside this window, well below the homing
+ *         timeout, so time-based transitions never fire.
+ */
+#define BENCH_TICK_WINDOW_MASK      0x3FFU
+
+/** EXTENDING scenario through actuator::Actuator<>, in actuator_bench_template.cpp. */
+double bench_template_extending(unsigned long iterations, unsigned repeats, uint32_t tick_mask);
+
+/* -------------------------------------------------------------------------- */
+/*   Scenarios                                                                */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    const char     *name;
+    ActuatorState_t state;
+    uint8_t         is_homing;
+    HomingPhase_t   phase;
+    uint8_t         rearm;          /**< Restore `state` before every call  */
+} BenchScenario_t;
+
+static const BenchScenario_t s_scenarios[] = {
+    { "state=IDLE",            ACTUATOR_IDLE,      0U, HOMING_PHASE_INIT,   0U },
+    { "state=EXTENDING",       ACTUATOR_EXTENDING, 0U, HOMING_PHASE_INIT,   0U },
+    { "state=SHRINKING",       ACTUATOR_SHRINKING, 0U, HOMING_PHASE_INIT,   0U },
+    { "state=ERROR",           ACTUATOR_ERROR,     0U, HOMING_PHASE_INIT,   1U },
+    { "homing=PHASE_INIT",     ACTUATOR_SHRINKING, 1U, HOMING_PHASE_INIT,   0U },
+    { "homing=PHASE_EXTEND",   ACTUATOR_EXTENDING, 1U, HOMING_PHASE_EXTEND, 0U },
+    { "homing=PHASE_SHRINK",   ACTUATOR_SHRINKING, 1U, HOMING_PHASE_SHRINK, 0U },
+    { "homing=PHASE_MIDDLE",   ACTUATOR_EXTENDING, 1U, HOMING_PHASE_MIDDLE, 0U },
+};
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static void bench_setup(ActuatorControl_t *p_act, const BenchScenario_t *p_sc)
+{
+    const ActuatorConfig_t config = {
+        .extend_active_level = GPIO_PIN_SET,
+        .shrink_active_level = GPIO_PIN_SET,
+        .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+        .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+        .homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT,
+        .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+        .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+        .park_position       = ACTUATOR_PARK_POSITION,
+
+        .extend_control_port = (void*)GPIOB,
+        .extend_control_pin  = EXTEND_CNTR_Pin,
+        .shrink_control_port = (void*)GPIOB,
+        .shrink_control_pin  = SHRINK_CNTR_Pin,
+        .extend_switch_port  = (void*)GPIOB,
+        .extend_switch_pin   = EXTEND_SWITCH_Pin,
+        .shrink_switch_port  = (void*)GPIOB,
+        .shrink_switch_pin   = SHRINK_SWITCH_Pin,
+        .led_extend_port     = (void*)GPIOB,
+        .led_extend_pin      = LED_EXTEND_Pin,
+        .led_shrink_port     = (void*)GPIOB,
+        .led_shrink_pin      = LED_SHRINK_Pin
+    };
+
+    host_hal_reset();
+    actuator_init(p_act, &config);
+
+    if (p_sc->state == ACTUATOR_EXTENDING) {
+        actuator_extend(p_act);
+    } else if (p_sc->state == ACTUATOR_SHRINKING) {
+        actuator_shrink(p_act);
+    } else {
+        p_act->state = p_sc->state;
+    }
+
+    if (p_sc->is_homing != 0U) {
+        p_act->is_homing                  = 1U;
+        p_act->homing_phase               = p_sc->phase;
+        p_act->homing_last_phase_end_time = 1U;
+        p_act->extend_time                = 0xFFFFFFFFU;  /* Midpoint never reached */
+    }
+}
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+static double bench_run(const BenchScenario_t *p_sc, unsigned long iterations)
+{
+    ActuatorControl_t act;
+    double            best = 0.0;
+
+    for (unsigned r = 0U; r < BENCH_REPEATS; r++) {
+        bench_setup(&act, p_sc);
+
+        const double start = bench_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            if (p_sc->rearm != 0U) {
+                act.state = p_sc->state;
+            }
+            actuator_update(&act, 1U + ((uint32_t)i & BENCH_TICK_WINDOW_MASK));
+        }
+        const double per_call = (bench_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief  Raw port pattern for sample `i`: a few pins chatter, the rest are
+ *         steady, so both debouncers take their normal paths.
+ */
+static uint16_t bench_port_sample(unsigned long i)
+{
+    return (uint16_t)(0x00F0U ^ (((i >> 2) & 1UL) ? 0x0003U : 0U) ^ ((i & 1UL) ? 0x0100U : 0U));
+}
+
+static double bench_debounce_single(unsigned long iterations)
+{
+    ButtonDebounce_t btn[16];
+    double           best = 0.0;
+    volatile uint8_t sink = 0U;
+
+    for (unsigned r = 0U; r < BENCH_REPEATS; r++) {
+        for (uint8_t pin = 0U; pin < 16U; pin++) {
+            button_debounce_init(&btn[pin], 1U, MS_TO_TICKS(DEBOUNCE_TIME_MS));
+        }
+
+        const double start = bench_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            const uint16_t idr = bench_port_sample(i);
+            for (uint8_t pin = 0U; pin < 16U; pin++) {
+                button_debounce_update(&btn[pin], (uint8_t)((idr >> pin) & 1U), (uint32_t)i);
+            }
+            sink ^= button_debounce_just_pressed(&btn[i & 15UL]);
+        }
+        const double per_call = (bench_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    (void)sink;
+    return best;
+}
+
+static double bench_debounce_port(unsigned long iterations)
+{
+    ButtonDebouncePort_t port;
+    double               best = 0.0;
+    volatile uint16_t    sink = 0U;
+
+    for (unsigned r = 0U; r < BENCH_REPEATS; r++) {
+        button_debounce_port_init(&port, 0xFFFFU, 0xFFFFU, (uint8_t)DEBOUNCE_TIME_MS);
+
+        const double start = bench_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            (void)button_debounce_port_update(&port, bench_port_sample(i));
+            sink ^= button_debounce_port_just_pressed(&port);
+        }
+        const double per_call = (bench_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    (void)sink;
+    return best;
+}
+
+/**
+ * @brief  Four actuators: relays and LEDs on GPIOA, switches on GPIOB.
+ */
+static void bench_group_configs(ActuatorConfig_t cfgs[ACTUATOR_GROUP_MAX_ACTUATORS])
+{
+    for (uint8_t a = 0U; a < ACTUATOR_GROUP_MAX_ACTUATORS; a++) {
+        const ActuatorConfig_t cfg = {
+            .extend_active_level = GPIO_PIN_SET,
+            .shrink_active_level = GPIO_PIN_SET,
+            .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+            .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+            .homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT,
+            .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+            .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+            .park_position       = ACTUATOR_PARK_POSITION,
+
+            .extend_control_port = (void*)GPIOA,
+            .extend_control_pin  = (uint16_t)(1U << (4U * a)),
+            .shrink_control_port = (void*)GPIOA,
+            .shrink_control_pin  = (uint16_t)(2U << (4U * a)),
+            .extend_switch_port  = (void*)GPIOB,
+            .extend_switch_pin   = (uint16_t)(1U << (2U * a)),
+            .shrink_switch_port  = (void*)GPIOB,
+            .shrink_switch_pin   = (uint16_t)(2U << (2U * a)),
+            .led_extend_port     = (void*)GPIOA,
+            .led_extend_pin      = (uint16_t)(4U << (4U * a)),
+            .led_shrink_port     = (void*)GPIOA,
+            .led_shrink_pin      = (uint16_t)(8U << (4U * a))
+        };
+        cfgs[a] = cfg;
+    }
+}
+
+static double bench_four_single(unsigned long iterations)
+{
+    ActuatorConfig_t  cfgs[ACTUATOR_GROUP_MAX_ACTUATORS];
+    ActuatorControl_t act[ACTUATOR_GROUP_MAX_ACTUATORS];
+    double            best = 0.0;
+
+    bench_group_configs(cfgs);
+
+    for (unsigned r = 0U; r < BENCH_REPEATS; r++) {
+        host_hal_reset();
+        for (uint8_t a = 0U; a < ACTUATOR_GROUP_MAX_ACTUATORS; a++) {
+            actuator_init(&act[a], &cfgs[a]);
+            actuator_extend(&act[a]);
+        }
+
+        const double start = bench_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            const uint32_t now = 1U + ((uint32_t)i & BENCH_TICK_WINDOW_MASK);
+            for (uint8_t a = 0U; a < ACTUATOR_GROUP_MAX_ACTUATORS; a++) {
+                actuator_update(&act[a], now);
+            }
+        }
+        const double per_call = (bench_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    return best;
+}
+
+static double bench_four_group(unsigned long iterations)
+{
+    ActuatorConfig_t cfgs[ACTUATOR_GROUP_MAX_ACTUATORS];
+    ActuatorGroup_t  group;
+    double           best = 0.0;
+
+    bench_group_configs(cfgs);
+
+    for (unsigned r = 0U; r < BENCH_REPEATS; r++) {
+        host_hal_reset();
+        (void)actuator_group_init(&group, cfgs, ACTUATOR_GROUP_MAX_ACTUATORS);
+        for (uint8_t a = 0U; a < ACTUATOR_GROUP_MAX_ACTUATORS; a++) {
+            actuator_extend(actuator_group_get(&group, a));
+        }
+
+        const double start = bench_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            actuator_group_update(&group, 1U + ((uint32_t)i & BENCH_TICK_WINDOW_MASK));
+        }
+        const double per_call = (bench_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    return best;
+}
+
+/** Telemetry transmitter that accepts every buffer at once. */
+static uint8_t bench_telemetry_tx(const uint8_t *p_data, uint16_t length)
+{
+    (void)p_data;
+    (void)length;
+    return 1U;
+}
+
+/**
+ * @brief  Telemetry sample of four actuators, due on every call.
+ */
+static double bench_telemetry(unsigned long iterations)
+{
+    ActuatorConfig_t    cfgs[ACTUATOR_GROUP_MAX_ACTUATORS];
+    ActuatorGroup_t     group;
+    ActuatorTelemetry_t tel;
+    double              best = 0.0;
+
+    bench_group_configs(cfgs);
+
+    for (unsigned r = 0U; r < BENCH_REPEATS; r++) {
+        host_hal_reset();
+        (void)actuator_group_init(&group, cfgs, ACTUATOR_GROUP_MAX_ACTUATORS);
+        actuator_telemetry_init(&tel, 1U, bench_telemetry_tx, 0U);
+
+        const double start = bench_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            actuator_telemetry_update(&tel, group.actuators, group.actuator_count, (uint32_t)i);
+            (void)actuator_telemetry_tx_done(&tel);
+        }
+        const double per_call = (bench_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    return best;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 0);
+        if (iterations == 0UL) {
+            fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("# actuator_update() cost, best of %u x %lu calls, %s GPIO driver\n",
+           BENCH_REPEATS, iterations, (ACTUATOR_GPIO_LL != 0U) ? "LL" : "HAL");
+    printf("%-24s %10s\n", "scenario", "ns/call");
+
+    for (size_t i = 0U; i < (sizeof(s_scenarios) / sizeof(s_scenarios[0])); i++) {
+        printf("%-24s %10.2f\n", s_scenarios[i].name, bench_run(&s_scenarios[i], iterations));
+    }
+    printf("%-24s %10.2f\n", "state=EXTENDING (C++)",
+           bench_template_extending(iterations, BENCH_REPEATS, BENCH_TICK_WINDOW_MASK));
+
+    printf("\n# 16-pin port debounce cost, best of %u x %lu samples\n",
+           BENCH_REPEATS, iterations);
+    printf("%-24s %10s\n", "debouncer", "ns/sample");
+    printf("%-24s %10.2f\n", "16 x ButtonDebounce_t", bench_debounce_single(iterations));
+    printf("%-24s %10.2f\n", "ButtonDebouncePort_t", bench_debounce_port(iterations));
+
+    printf("\n# %u extending actuators, best of %u x %lu passes\n",
+           ACTUATOR_GROUP_MAX_ACTUATORS, BENCH_REPEATS, iterations);
+    printf("%-24s %10s\n", "update", "ns/pass");
+    printf("%-24s %10.2f\n", "actuator_update() each", bench_four_single(iterations));
+    printf("%-24s %10.2f\n", "actuator_group_update()", bench_four_group(iterations));
+    printf("%-24s %10.2f\n", "telemetry sample", bench_telemetry(iterations));
+
+    return 0;
+}
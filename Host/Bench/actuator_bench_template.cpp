@@ -0,0 +1,49 @@
+/**
+ * @file    actuator_bench_template.cpp
+ * @brief   actuator_bench scenario for the C++ front end (actuator.hpp).
+ *
+ * Same run as `state=EXTENDING`, with the board pin map as template
+ * arguments instead of an #ActuatorConfig_t.
+ */
+
+#include <time.h>
+
+#include "actuator.hpp"
+#include "main.h"                   /* DEBOUNCE_TIME_MS, HOMING_TIMEOUT_MS */
+
+typedef actuator::Actuator<actuator::Pin<actuator::PortB, 0U>,
+                           actuator::Pin<actuator::PortB, 1U>,
+                           actuator::Pin<actuator::PortB, 7U>,
+                           actuator::Pin<actuator::PortB, 8U>,
+                           actuator::Pin<actuator::PortB, 5U>,
+                           actuator::Pin<actuator::PortB, 6U> > BenchActuator;
+
+static double bench_template_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+extern "C" double bench_template_extending(unsigned long iterations, unsigned repeats, uint32_t tick_mask)
+{
+    static BenchActuator s_act;
+    double               best = 0.0;
+
+    for (unsigned r = 0U; r < repeats; r++) {
+        host_hal_reset();
+        s_act.init(MS_TO_TICKS(DEBOUNCE_TIME_MS), MS_TO_TICKS(HOMING_TIMEOUT_MS));
+        s_act.extend();
+
+        const double start = bench_template_now_ns();
+        for (unsigned long i = 0UL; i < iterations; i++) {
+            s_act.update(1U + ((uint32_t)i & tick_mask));
+        }
+        const double per_call = (bench_template_now_ns() - start) / (double)iterations;
+
+        if ((r == 0U) || (per_call < best)) {
+            best = per_call;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file    actuator_current_replay.c
+ * @brief   Replays a recorded motor-current trace through the stall detector
+ *          and the real state machine.
+ *
+ * The trace is one raw ADC reading per line (`#` starts a comment), sampled
+ * at a fixed rate — e.g. the current_sense ring dumped from the debugger
+ * while the motor runs into an end stop. The samples are copied into a ring
+ * of #CURRENT_SENSE_RING_SIZE half a ring at a time, as DMA1 channel 1 does,
+ * and after each half the detector runs exactly as in
+ * current_sense_block_callback() on the target. The actuator is extended
+ * from rest when the first sample is taken; actuator_update() runs every
+ * millisecond of trace time, and once more right after a stall.
+ *
+ * Usage:  actuator_current_replay [options] [FILE]      (default: stdin)
+ *   -r, --rate HZ             sample rate                 (default 47619)
+ *   -t, --threshold COUNTS    stall threshold, ADC counts (default 1241)
+ *   -b, --blank MS            inrush blanking             (default 100)
+ *   -s, --stall MS            time over the threshold     (default 2)
+ *   -k, --block-shift N       log2 samples per block      (default 5)
+ *   -e, --end-stop            a stall is the end stop (sensorless), not a jam
+ *   -g, --generate MS         print a synthetic trace instead: inrush, run,
+ *                             and a stall MS after the start
+ *
+ *   actuator_current_replay -g 1500 | actuator_current_replay -e
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "actuator_control.h"
+#include "actuator_current.h"
+#include "current_sense.h"          /* Ring size, sample rate, block size */
+#include "main.h"                   /* Board pin map, CURRENT_STALL_* defaults */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/** Tick of the extend command (tick 0 is reserved by the homing sequence). */
+#define REPLAY_START_TICK           1U
+
+/* Synthetic motor, in ADC counts (0.5 V/A): inrush decaying into the running
+   current, brush noise on top, and the stall current once the rod stops */
+#define SYNTH_INRUSH                3500.0
+#define SYNTH_INRUSH_TAU_MS         15.0
+#define SYNTH_RUN                   600.0
+#define SYNTH_NOISE                 150.0
+#define SYNTH_STALL                 3000.0
+#define SYNTH_STALL_RISE_MS         5.0
+#define SYNTH_TAIL_MS               200U
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static const char *const s_state_names[] = { "IDLE", "EXTENDING", "SHRINKING", "ERROR" };
+
+static volatile uint16_t s_ring[CURRENT_SENSE_RING_SIZE];
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static void replay_usage(const char *p_prog)
+{
+    fprintf(stderr,
+            "usage: %s [-r HZ] [-t COUNTS] [-b MS] [-s MS] [-k N] [-e] [FILE]\n"
+            "       %s -g MS [-r HZ]\n", p_prog, p_prog);
+}
+
+static uint16_t replay_ms_to_blocks(uint32_t ms, uint32_t rate, uint8_t shift)
+{
+    const uint64_t per_block = 1000ULL << shift;
+    return (uint16_t)((((uint64_t)ms * rate) + per_block - 1ULL) / per_block);
+}
+
+/** Next sample of the trace; 0 at the end. */
+static int replay_read(FILE *p_in, uint16_t *p_sample)
+{
+    char line[128];
+
+    while (fgets(line, (int)sizeof(line), p_in) != NULL) {
+        char *p_text = line + strspn(line, " \t");
+        char *p_end  = NULL;
+
+        if ((*p_text == '#') || (*p_text == '\n') || (*p_text == '\0')) {
+            continue;
+        }
+        const long value = strtol(p_text, &p_end, 0);
+        if ((p_end == p_text) || (value < 0L) || (value > 0xFFFFL)) {
+            fprintf(stderr, "bad sample: %s", line);
+            continue;
+        }
+        *p_sample = (uint16_t)value;
+        return 1;
+    }
+    return 0;
+}
+
+static int replay_generate(uint32_t stall_ms, uint32_t rate)
+{
+    const uint32_t count = (uint32_t)(((uint64_t)(stall_ms + SYNTH_TAIL_MS) * rate) / 1000U);
+
+    srand(1U);
+    printf("# synthetic: %u Hz, stall at %u ms\n", (unsigned)rate, (unsigned)stall_ms);
+    for (uint32_t n = 0U; n < count; n++) {
+        const double t_ms  = (1000.0 * n) / rate;
+        const double noise = SYNTH_NOISE * ((2.0 * rand() / RAND_MAX) - 1.0);
+        double       level = SYNTH_RUN + ((SYNTH_INRUSH - SYNTH_RUN) * exp(-t_ms / SYNTH_INRUSH_TAU_MS));
+
+        if (t_ms >= stall_ms) {
+            const double rise = fmin((t_ms - stall_ms) / SYNTH_STALL_RISE_MS, 1.0);
+            level += (SYNTH_STALL - SYNTH_RUN) * rise;
+        }
+        level = fmin(fmax(level + noise, 0.0), 4095.0);
+        printf("%u\n", (unsigned)lround(level));
+    }
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    uint32_t rate      = CURRENT_SENSE_SAMPLE_HZ;
+    uint32_t threshold = CURRENT_STALL_THRESHOLD;
+    uint32_t blank_ms  = CURRENT_STALL_BLANK_MS;
+    uint32_t stall_ms  = CURRENT_STALL_TIME_MS;
+    uint32_t shift     = CURRENT_SENSE_BLOCK_SHIFT;
+    uint8_t  end_stop  = 0U;
+    long     generate  = -1L;
+
+    static const struct option s_options[] = {
+        { "rate",        required_argument, NULL, 'r' },
+        { "threshold",   required_argument, NULL, 't' },
+        { "blank",       required_argument, NULL, 'b' },
+        { "stall",       required_argument, NULL, 's' },
+        { "block-shift", required_argument, NULL, 'k' },
+        { "end-stop",    no_argument,       NULL, 'e' },
+        { "generate",    required_argument, NULL, 'g' },
+        { NULL, 0, NULL, 0 }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "r:t:b:s:k:eg:", s_options, NULL)) != -1) {
+        switch (opt) {
+            case 'r': rate      = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': threshold = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'b': blank_ms  = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': stall_ms  = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'k': shift     = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'e': end_stop  = 1U;                                 break;
+            case 'g': generate  = strtol(optarg, NULL, 0);            break;
+            default:
+                replay_usage(argv[0]);
+                return 1;
+        }
+    }
+    if ((rate == 0U) || (threshold > 0xFFFFU) || (shift > 8U) || (argc - optind > 1)) {
+        replay_usage(argv[0]);
+        return 1;
+    }
+    if (generate >= 0L) {
+        return replay_generate((uint32_t)generate, rate);
+    }
+
+    FILE *p_in = stdin;
+    if (optind < argc) {
+        p_in = fopen(argv[optind], "r");
+        if (p_in == NULL) {
+            perror(argv[optind]);
+            return 1;
+        }
+    }
+
+    /* ---- Detector, as set up in main.c ---- */
+    const ActuatorCurrentConfig_t cur_cfg = {
+        .threshold    = (uint16_t)threshold,
+        .blank_blocks = replay_ms_to_blocks(blank_ms, rate, (uint8_t)shift),
+        .stall_blocks = replay_ms_to_blocks(stall_ms, rate, (uint8_t)shift),
+        .block_shift  = (uint8_t)shift
+    };
+    ActuatorCurrent_t current;
+    if (actuator_current_init(&current, s_ring, CURRENT_SENSE_RING_SIZE, &cur_cfg) == 0U) {
+        replay_usage(argv[0]);
+        return 1;
+    }
+
+    /* ---- Actuator with the switch inputs left open (pulled down) ---- */
+    const ActuatorConfig_t act_cfg = {
+        .extend_active_level = GPIO_PIN_SET,
+        .shrink_active_level = GPIO_PIN_SET,
+        .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+        .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+        .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+        .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+        .park_position       = ACTUATOR_PARK_POSITION,
+        .stall_end_stop      = end_stop,
+
+        .extend_control_port = (void*)EXTEND_CNTR_GPIO_Port,
+        .extend_control_pin  = EXTEND_CNTR_Pin,
+        .shrink_control_port = (void*)SHRINK_CNTR_GPIO_Port,
+        .shrink_control_pin  = SHRINK_CNTR_Pin,
+        .extend_switch_port  = (void*)EXTEND_SWITCH_GPIO_Port,
+        .extend_switch_pin   = EXTEND_SWITCH_Pin,
+        .shrink_switch_port  = (void*)SHRINK_SWITCH_GPIO_Port,
+        .shrink_switch_pin   = SHRINK_SWITCH_Pin,
+        .led_extend_port     = (void*)LED_EXTEND_GPIO_Port,
+        .led_extend_pin      = LED_EXTEND_Pin,
+        .led_shrink_port     = (void*)LED_SHRINK_GPIO_Port,
+        .led_shrink_pin      = LED_SHRINK_Pin
+    };
+    ActuatorControl_t act;
+
+    host_hal_reset();
+    host_hal_set_tick(REPLAY_START_TICK);
+    actuator_init(&act, &act_cfg);
+    actuator_extend(&act);
+    actuator_update(&act, REPLAY_START_TICK);
+
+    printf("# %u Hz, threshold %u, block %u samples, blank %u blocks, stall %u blocks, %s\n",
+           (unsigned)rate, (unsigned)threshold, 1U << shift, (unsigned)cur_cfg.blank_blocks,
+           (unsigned)cur_cfg.stall_blocks, (end_stop != 0U) ? "end stop" : "jam");
+
+    /* ---- Half a ring per "DMA interrupt", one update per elapsed ms ---- */
+    const uint16_t half      = CURRENT_SENSE_RING_SIZE / 2U;
+    uint16_t       write_pos = 0U;
+    uint32_t       samples   = 0U;
+    uint32_t       tick      = REPLAY_START_TICK;
+    uint8_t        stalled   = 0U;
+    uint8_t        more      = 1U;
+
+    while ((more != 0U) && (stalled == 0U)) {
+        uint16_t sample;
+        uint16_t n = 0U;
+
+        while ((n < half) && (more != 0U)) {
+            more = (uint8_t)replay_read(p_in, &sample);
+            if (more != 0U) {
+                s_ring[write_pos] = sample;
+                write_pos = (uint16_t)((write_pos + 1U) & (CURRENT_SENSE_RING_SIZE - 1U));
+                n++;
+            }
+        }
+        samples += n;
+
+        const uint32_t now = REPLAY_START_TICK + (uint32_t)(((uint64_t)samples * 1000U) / rate);
+        while (tick < now) {
+            tick++;
+            host_hal_set_tick(tick);
+            actuator_update(&act, tick);
+        }
+
+        if (n == half) {
+            actuator_current_set_running(&current, (uint8_t)act.output);
+            if (actuator_current_process(&current, write_pos) != 0U) {
+                const ActuatorState_t before = actuator_get_state(&act);
+
+                actuator_stall_isr(&act);
+                actuator_update(&act, tick);    /* s_wake_event */
+                stalled = 1U;
+                printf("stall at %.2f ms (sample %u), block level %u\n",
+                       (1000.0 * samples) / rate, (unsigned)samples, (unsigned)current.level);
+                printf("actuator %s -> %s, position %u permille, relays %s\n",
+                       s_state_names[before], s_state_names[actuator_get_state(&act)],
+                       (unsigned)actuator_get_position(&act),
+                       (act.output == ACTUATOR_OUTPUT_STOP) ? "released" : "energised");
+            }
+        }
+    }
+
+    if (stalled == 0U) {
+        printf("no stall in %.2f ms (%u samples), peak block level %u\n",
+               (1000.0 * samples) / rate, (unsigned)samples, (unsigned)current.peak);
+    }
+    if (p_in != stdin) {
+        fclose(p_in);
+    }
+    return (stalled != 0U) ? 0 : 2;
+}
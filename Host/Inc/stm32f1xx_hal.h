@@ -0,0 +1,173 @@
+/**
+ * @file    stm32f1xx_hal.h
+ * @brief   Host (Linux) stand-in for the subset of the STM32F1 HAL used by
+ *          the actuator modules.
+ *
+ * Only the types and calls that actuator_control.c, button_debounce.c and
+ * actuator_storage.c depend on are provided. GPIO ports are plain RAM
+ * structures with the same register layout as the real peripheral, so code
+ * that touches registers directly behaves the same way on the host. The
+ * calibration flash page is RAM as well, with the program rules of the
+ * F103 flash (see HAL_FLASH_Program()).
+ *
+ * @note    This header shadows the real HAL header and must only be on the
+ *          include path of host builds (see Host/CMakeLists.txt).
+ */
+
+#ifndef HOST_STM32F1XX_HAL_H
+#define HOST_STM32F1XX_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*   GPIO                                                                     */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  GPIO register block — same layout as the CMSIS definition.
+ */
+typedef struct {
+    volatile uint32_t CRL;
+    volatile uint32_t CRH;
+    volatile uint32_t IDR;
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+    volatile uint32_t BRR;
+    volatile uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0      ((uint16_t)0x0001)
+#define GPIO_PIN_1      ((uint16_t)0x0002)
+#define GPIO_PIN_2      ((uint16_t)0x0004)
+#define GPIO_PIN_3      ((uint16_t)0x0008)
+#define GPIO_PIN_4      ((uint16_t)0x0010)
+#define GPIO_PIN_5      ((uint16_t)0x0020)
+#define GPIO_PIN_6      ((uint16_t)0x0040)
+#define GPIO_PIN_7      ((uint16_t)0x0080)
+#define GPIO_PIN_8      ((uint16_t)0x0100)
+#define GPIO_PIN_9      ((uint16_t)0x0200)
+#define GPIO_PIN_10     ((uint16_t)0x0400)
+#define GPIO_PIN_11     ((uint16_t)0x0800)
+#define GPIO_PIN_12     ((uint16_t)0x1000)
+#define GPIO_PIN_13     ((uint16_t)0x2000)
+#define GPIO_PIN_14     ((uint16_t)0x4000)
+#define GPIO_PIN_15     ((uint16_t)0x8000)
+#define GPIO_PIN_All    ((uint16_t)0xFFFF)
+
+/** Number of emulated GPIO ports (A..D, as on the STM32F103C8). */
+#define HOST_GPIO_PORT_COUNT    4U
+
+extern GPIO_TypeDef host_gpio_ports[HOST_GPIO_PORT_COUNT];
+
+#define GPIOA   (&host_gpio_ports[0])
+#define GPIOB   (&host_gpio_ports[1])
+#define GPIOC   (&host_gpio_ports[2])
+#define GPIOD   (&host_gpio_ports[3])
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void          HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/* -------------------------------------------------------------------------- */
+/*   Tick                                                                     */
+/* -------------------------------------------------------------------------- */
+
+uint32_t HAL_GetTick(void);
+
+/* -------------------------------------------------------------------------- */
+/*   Flash                                                                    */
+/* -------------------------------------------------------------------------- */
+
+typedef enum {
+    HAL_OK      = 0x00U,
+    HAL_ERROR   = 0x01U,
+    HAL_BUSY    = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+#define FLASH_PAGE_SIZE             0x400U
+#define FLASH_TYPEPROGRAM_HALFWORD  0x01U
+#define FLASH_TYPEPROGRAM_WORD      0x02U
+#define FLASH_TYPEERASE_PAGES       0x00U
+#define FLASH_BANK_1                1U
+
+/**
+ * @brief  Page erase request. Addresses are `uintptr_t` here: the same as
+ *         the HAL's uint32_t on the target, a full pointer on the host.
+ */
+typedef struct {
+    uint32_t  TypeErase;
+    uint32_t  Banks;
+    uintptr_t PageAddress;
+    uint32_t  NbPages;
+} FLASH_EraseInitTypeDef;
+
+/**
+ * @brief  The emulated flash is the `_calib_start` .. `_calib_end` page
+ *         (one #FLASH_PAGE_SIZE). Program and erase fail with HAL_ERROR
+ *         outside it or while locked; programming a half-word that is
+ *         neither erased nor being cleared to zero fails as PGERR would.
+ */
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uintptr_t Address, uint64_t Data);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError);
+
+/* -------------------------------------------------------------------------- */
+/*   Host-only helpers (not part of the HAL)                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Reset all emulated ports and the tick counter to zero, erase the
+ *         calibration page and relock the flash.
+ */
+void host_hal_reset(void);
+
+/**
+ * @brief  Set the value returned by HAL_GetTick().
+ * @param  tick  New tick value.
+ */
+void host_hal_set_tick(uint32_t tick);
+
+/**
+ * @brief  Drive an input pin level as seen through IDR.
+ * @param  GPIOx     Emulated port.
+ * @param  GPIO_Pin  Pin mask.
+ * @param  PinState  Level to apply.
+ */
+void host_gpio_set_input(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+/**
+ * @brief  Return the output data register of an emulated port, after
+ *         applying any BSRR / BRR store made since the last call.
+ * @param  GPIOx  Emulated port.
+ * @return Current ODR value.
+ */
+uint32_t host_gpio_get_output(GPIO_TypeDef *GPIOx);
+
+/**
+ * @brief  The emulated calibration page, for tests that craft records.
+ * @return Address of `_calib_start`.
+ */
+void *host_flash_page(void);
+
+/**
+ * @brief  Page erases made through HAL_FLASHEx_Erase() since the last
+ *         host_hal_reset().
+ */
+uint32_t host_flash_erase_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32F1XX_HAL_H */
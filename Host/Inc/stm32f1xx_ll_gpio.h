@@ -0,0 +1,36 @@
+/**
+ * @file    stm32f1xx_ll_gpio.h
+ * @brief   Host (Linux) stand-in for the subset of the STM32F1 LL GPIO
+ *          driver used by actuator_gpio.h.
+ *
+ * Register access on the emulated ports of stm32f1xx_hal.h; BSRR stores are
+ * latched into ODR the same way as direct stores (see stm32f1xx_hal_host.c).
+ *
+ * @note    This header shadows the real LL header and must only be on the
+ *          include path of host builds (see Host/CMakeLists.txt).
+ */
+
+#ifndef HOST_STM32F1XX_LL_GPIO_H
+#define HOST_STM32F1XX_LL_GPIO_H
+
+#include <stdint.h>
+
+#include "stm32f1xx_hal.h"          /* GPIO_TypeDef, emulated ports */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LL_GPIO_WriteReg(__INSTANCE__, __REG__, __VALUE__) ((__INSTANCE__)->__REG__ = (__VALUE__))
+#define LL_GPIO_ReadReg(__INSTANCE__, __REG__)             ((__INSTANCE__)->__REG__)
+
+static inline uint32_t LL_GPIO_ReadInputPort(GPIO_TypeDef *GPIOx)
+{
+    return GPIOx->IDR;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HOST_STM32F1XX_LL_GPIO_H */
@@ -0,0 +1,315 @@
+/**
+ * @file    actuator_plant.c
+ * @brief   Host-side physics stand-in for the linear actuator.
+ *
+ * Position moves linearly between events; events are relay changes taking
+ * effect, the carriage reaching an end stop, and individual bounce edges.
+ */
+
+#include "actuator_plant.h"
+
+#include <math.h>
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t plant_rand(ActuatorPlant_t *p_plant)
+{
+    /* xorshift32 — deterministic per seed, cheap enough for the hot loop */
+    uint32_t x = p_plant->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p_plant->rng = x;
+    return x;
+}
+
+/**
+ * @brief  Set a switch to its new mechanical level at `now` and schedule the
+ *         bounce edges that follow. The last toggle restores `closed`.
+ */
+static void plant_switch_actuate(ActuatorPlant_t *p_plant, PlantSwitch_t *p_sw, uint8_t closed)
+{
+    const ActuatorPlantConfig_t *p_cfg = &p_plant->config;
+
+    p_sw->closed       = closed;
+    p_sw->toggle_count = 0U;
+    p_sw->toggle_index = 0U;
+
+    if ((p_cfg->bounce_ms == 0U) || (p_cfg->bounces == 0U)) {
+        return;
+    }
+
+    const uint8_t bounces = (p_cfg->bounces > PLANT_MAX_BOUNCES) ? PLANT_MAX_BOUNCES : p_cfg->bounces;
+
+    for (uint8_t i = 0U; i < (uint8_t)(2U * bounces); i++) {
+        const uint32_t t = p_plant->now + 1U + (plant_rand(p_plant) % p_cfg->bounce_ms);
+
+        /* Insertion sort — at most 16 entries */
+        uint8_t j = i;
+        while ((j > 0U) && (p_sw->toggle_time[j - 1U] > t)) {
+            p_sw->toggle_time[j] = p_sw->toggle_time[j - 1U];
+            j--;
+        }
+        p_sw->toggle_time[j] = t;
+    }
+    p_sw->toggle_count = (uint8_t)(2U * bounces);
+}
+
+static uint32_t plant_switch_next_toggle(const PlantSwitch_t *p_sw)
+{
+    return (p_sw->toggle_index < p_sw->toggle_count)
+           ? p_sw->toggle_time[p_sw->toggle_index]
+           : PLANT_NO_EVENT;
+}
+
+static void plant_switch_apply_toggles(PlantSwitch_t *p_sw, uint32_t now)
+{
+    while ((p_sw->toggle_index < p_sw->toggle_count) &&
+           (p_sw->toggle_time[p_sw->toggle_index] <= now)) {
+        p_sw->closed = (uint8_t)!p_sw->closed;
+        p_sw->toggle_index++;
+    }
+}
+
+static double plant_speed_mm_per_tick(const ActuatorPlant_t *p_plant)
+{
+    if (p_plant->direction > 0) {
+        return p_plant->speed_scale * p_plant->config.extend_speed_mm_s / 1000.0;
+    }
+    if (p_plant->direction < 0) {
+        return p_plant->speed_scale * p_plant->config.shrink_speed_mm_s / 1000.0;
+    }
+    return 0.0;
+}
+
+/** Non-zero while the carriage sits on the end stop of that switch. */
+static uint8_t plant_at_extend_end(const ActuatorPlant_t *p_plant)
+{
+    return (p_plant->position_mm >= p_plant->config.stroke_mm) ? 1U : 0U;
+}
+
+static uint8_t plant_at_shrink_end(const ActuatorPlant_t *p_plant)
+{
+    return (p_plant->position_mm <= 0.0) ? 1U : 0U;
+}
+
+/** Move the carriage from `now` to `t` at the current drive. */
+static void plant_move(ActuatorPlant_t *p_plant, uint32_t t)
+{
+    const double travel = plant_speed_mm_per_tick(p_plant) * (double)(t - p_plant->now);
+
+    /* Driving against a mechanical stop — the wear we want to minimise */
+    if (((p_plant->direction > 0) && plant_at_extend_end(p_plant)) ||
+        ((p_plant->direction < 0) && plant_at_shrink_end(p_plant))) {
+        p_plant->stall_ticks += t - p_plant->now;
+    }
+
+    const uint8_t at_end = (uint8_t)(plant_at_extend_end(p_plant) || plant_at_shrink_end(p_plant));
+
+    if (p_plant->direction > 0) {
+        p_plant->position_mm += travel;
+        if (p_plant->position_mm >= (p_plant->config.stroke_mm - 1e-9)) {
+            p_plant->position_mm = p_plant->config.stroke_mm;
+        }
+    } else if (p_plant->direction < 0) {
+        p_plant->position_mm -= travel;
+        if (p_plant->position_mm <= 1e-9) {
+            p_plant->position_mm = 0.0;
+        }
+    }
+    p_plant->now = t;
+
+    /* The impact the ramps are there to soften */
+    if ((at_end == 0U) && (plant_at_extend_end(p_plant) || plant_at_shrink_end(p_plant))) {
+        const double speed = plant_speed_mm_per_tick(p_plant) * 1000.0;
+        p_plant->hit_speed_mm_s = (speed > p_plant->hit_speed_mm_s) ? speed : p_plant->hit_speed_mm_s;
+    }
+}
+
+static void plant_relay_apply(PlantRelay_t *p_relay, uint32_t now)
+{
+    if ((p_relay->pending != 0U) && (p_relay->time <= now)) {
+        p_relay->pending = 0U;
+        p_relay->on      = p_relay->pending_on;
+    }
+}
+
+static void plant_relay_command(PlantRelay_t *p_relay, uint8_t on, uint32_t now, uint32_t delay)
+{
+    const uint8_t commanded = (p_relay->pending != 0U) ? p_relay->pending_on : p_relay->on;
+
+    if (on != commanded) {
+        p_relay->pending    = 1U;
+        p_relay->pending_on = on;
+        p_relay->time       = now + delay;
+    }
+}
+
+/** Apply every event due at the current plant time. */
+static void plant_apply_events(ActuatorPlant_t *p_plant)
+{
+    plant_relay_apply(&p_plant->extend_relay, p_plant->now);
+    plant_relay_apply(&p_plant->shrink_relay, p_plant->now);
+
+    const uint8_t ext = p_plant->extend_relay.on;
+    const uint8_t shr = p_plant->shrink_relay.on;
+    const int8_t  direction = ((ext != 0U) && (shr == 0U)) ? 1 :
+                              ((shr != 0U) && (ext == 0U)) ? -1 : 0;
+
+    if (direction != p_plant->direction) {
+        p_plant->direction = direction;
+
+        /* Leaving an end stop breaks its contact */
+        if ((p_plant->direction < 0) && plant_at_extend_end(p_plant)) {
+            p_plant->position_mm -= 1e-6;
+            plant_switch_actuate(p_plant, &p_plant->extend_switch, 0U);
+        } else if ((p_plant->direction > 0) && plant_at_shrink_end(p_plant)) {
+            p_plant->position_mm += 1e-6;
+            plant_switch_actuate(p_plant, &p_plant->shrink_switch, 0U);
+        }
+    }
+
+    /* Reaching an end stop makes its contact (once per arrival) */
+    if ((p_plant->direction > 0) && plant_at_extend_end(p_plant) &&
+        (p_plant->extend_switch.closed == 0U) &&
+        (plant_switch_next_toggle(&p_plant->extend_switch) == PLANT_NO_EVENT)) {
+        plant_switch_actuate(p_plant, &p_plant->extend_switch, 1U);
+    } else if ((p_plant->direction < 0) && plant_at_shrink_end(p_plant) &&
+               (p_plant->shrink_switch.closed == 0U) &&
+               (plant_switch_next_toggle(&p_plant->shrink_switch) == PLANT_NO_EVENT)) {
+        plant_switch_actuate(p_plant, &p_plant->shrink_switch, 1U);
+    }
+
+    plant_switch_apply_toggles(&p_plant->extend_switch, p_plant->now);
+    plant_switch_apply_toggles(&p_plant->shrink_switch, p_plant->now);
+}
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+void actuator_plant_init(ActuatorPlant_t *p_plant,
+                         const ActuatorPlantConfig_t *p_cfg,
+                         double position_mm,
+                         uint32_t now,
+                         uint32_t seed)
+{
+    if ((p_plant == NULL) || (p_cfg == NULL)) {
+        return;
+    }
+
+    p_plant->config            = *p_cfg;
+    p_plant->direction         = 0;
+    p_plant->extend_relay      = (PlantRelay_t){ 0U, 0U, 0U, 0U };
+    p_plant->shrink_relay      = (PlantRelay_t){ 0U, 0U, 0U, 0U };
+    p_plant->now               = now;
+    p_plant->rng               = (seed != 0U) ? seed : 0x9E3779B9U;
+    p_plant->stall_ticks       = 0U;
+    p_plant->speed_scale       = 1.0;
+    p_plant->hit_speed_mm_s    = 0.0;
+
+    if (position_mm < 0.0) {
+        position_mm = 0.0;
+    } else if (position_mm > p_cfg->stroke_mm) {
+        position_mm = p_cfg->stroke_mm;
+    }
+    p_plant->position_mm = position_mm;
+
+    p_plant->extend_switch.closed       = plant_at_extend_end(p_plant);
+    p_plant->extend_switch.toggle_count = 0U;
+    p_plant->extend_switch.toggle_index = 0U;
+    p_plant->shrink_switch.closed       = plant_at_shrink_end(p_plant);
+    p_plant->shrink_switch.toggle_count = 0U;
+    p_plant->shrink_switch.toggle_index = 0U;
+}
+
+void actuator_plant_drive(ActuatorPlant_t *p_plant,
+                          uint8_t extend_on,
+                          uint8_t shrink_on)
+{
+    if (p_plant == NULL) {
+        return;
+    }
+
+    const uint32_t off_delay = p_plant->config.relay_delay_ms;
+    const uint32_t on_delay  = off_delay + p_plant->config.spinup_ms;
+
+    plant_relay_command(&p_plant->extend_relay, (uint8_t)(extend_on != 0U), p_plant->now,
+                        (extend_on != 0U) ? on_delay : off_delay);
+    plant_relay_command(&p_plant->shrink_relay, (uint8_t)(shrink_on != 0U), p_plant->now,
+                        (shrink_on != 0U) ? on_delay : off_delay);
+
+    if (on_delay == 0U) {
+        plant_apply_events(p_plant);
+    }
+}
+
+uint32_t actuator_plant_next_event(const ActuatorPlant_t *p_plant)
+{
+    if (p_plant == NULL) {
+        return PLANT_NO_EVENT;
+    }
+
+    uint32_t next = PLANT_NO_EVENT;
+
+    if ((p_plant->extend_relay.pending != 0U) && (p_plant->extend_relay.time < next)) {
+        next = p_plant->extend_relay.time;
+    }
+    if ((p_plant->shrink_relay.pending != 0U) && (p_plant->shrink_relay.time < next)) {
+        next = p_plant->shrink_relay.time;
+    }
+
+    /* Arrival at the end stop the motor is driving towards */
+    const double speed = plant_speed_mm_per_tick(p_plant);
+    double       distance = -1.0;
+    if ((p_plant->direction > 0) && !plant_at_extend_end(p_plant)) {
+        distance = p_plant->config.stroke_mm - p_plant->position_mm;
+    } else if ((p_plant->direction < 0) && !plant_at_shrink_end(p_plant)) {
+        distance = p_plant->position_mm;
+    }
+    if ((distance >= 0.0) && (speed > 0.0)) {
+        double ticks = ceil(distance / speed);
+        if (ticks < 1.0) {
+            ticks = 1.0;
+        }
+        const double arrival = (double)p_plant->now + ticks;
+        if (arrival < (double)next) {
+            next = (uint32_t)arrival;
+        }
+    }
+
+    const uint32_t ext_toggle = plant_switch_next_toggle(&p_plant->extend_switch);
+    const uint32_t shr_toggle = plant_switch_next_toggle(&p_plant->shrink_switch);
+    if (ext_toggle < next) {
+        next = ext_toggle;
+    }
+    if (shr_toggle < next) {
+        next = shr_toggle;
+    }
+
+    return next;
+}
+
+void actuator_plant_advance(ActuatorPlant_t *p_plant, uint32_t t)
+{
+    if (p_plant == NULL) {
+        return;
+    }
+
+    for (;;) {
+        const uint32_t next = actuator_plant_next_event(p_plant);
+        if ((next == PLANT_NO_EVENT) || (next > t)) {
+            break;
+        }
+        plant_move(p_plant, next);
+        plant_apply_events(p_plant);
+    }
+    plant_move(p_plant, t);
+
+    /* The rounded-up arrival tick can lie past a `t` at which the move
+       already clamped onto the end stop — close the contact here then */
+    plant_apply_events(p_plant);
+}
@@ -0,0 +1,130 @@
+/**
+ * @file    actuator_plant.h
+ * @brief   Host-side physics stand-in for the linear actuator.
+ *
+ * Models a DC linear actuator driven by two relays, with per-direction travel
+ * speed, relay switching delay, motor spin-up and contact bounce on both
+ * limit switches. An H-bridge drive scales the speed by its PWM duty
+ * (`speed_scale`).
+ *
+ * The model is event-driven: it never advances in fixed steps. Callers ask
+ * for the next tick at which a switch level can change
+ * (#actuator_plant_next_event()), jump straight to it and call
+ * actuator_update() there. This is what makes millions of simulated homing
+ * cycles per second possible.
+ *
+ * @note    Time is in ticks (1 tick = 1 ms, as on the target).
+ */
+
+#ifndef ACTUATOR_PLANT_H
+#define ACTUATOR_PLANT_H
+
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+/*   Constants                                                                */
+/* -------------------------------------------------------------------------- */
+
+/** Maximum number of bounces (open + close pairs) per switch contact. */
+#define PLANT_MAX_BOUNCES       8U
+
+/** Returned by #actuator_plant_next_event() when nothing is scheduled. */
+#define PLANT_NO_EVENT          0xFFFFFFFFU
+
+/* -------------------------------------------------------------------------- */
+/*   Structures                                                               */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Physical parameters of the simulated actuator.
+ */
+typedef struct {
+    double   stroke_mm;                 /**< Distance between the two end stops      */
+    double   extend_speed_mm_s;         /**< Travel speed while extending            */
+    double   shrink_speed_mm_s;         /**< Travel speed while shrinking            */
+    uint32_t relay_delay_ms;            /**< Delay from output change to motor drive */
+    uint32_t spinup_ms;                 /**< Extra start delay: motor spin-up; a stop
+                                             takes relay_delay_ms alone               */
+    uint32_t bounce_ms;                 /**< Window in which a contact bounces       */
+    uint8_t  bounces;                   /**< Bounces per make / break (0..8)         */
+} ActuatorPlantConfig_t;
+
+/**
+ * @brief  One limit switch with its pending bounce edges.
+ */
+typedef struct {
+    uint8_t  closed;                            /**< Current raw contact level   */
+    uint8_t  toggle_count;                      /**< Pending toggles             */
+    uint8_t  toggle_index;                      /**< Next toggle to apply        */
+    uint32_t toggle_time[2U * PLANT_MAX_BOUNCES];/**< Ascending toggle ticks     */
+} PlantSwitch_t;
+
+/**
+ * @brief  One relay; its contacts follow the coil after `relay_delay_ms`.
+ */
+typedef struct {
+    uint8_t  on;                        /**< Contact state                       */
+    uint8_t  pending;                   /**< Non-zero while a change is in flight */
+    uint8_t  pending_on;                /**< Contact state after the change      */
+    uint32_t time;                      /**< Tick at which the change applies    */
+} PlantRelay_t;
+
+/**
+ * @brief  Simulated actuator state.
+ */
+typedef struct {
+    ActuatorPlantConfig_t config;
+    double        position_mm;          /**< 0 = fully shrunk, stroke = fully extended */
+    int8_t        direction;            /**< Motor drive: -1 shrink, 0 off, +1 extend  */
+    PlantRelay_t  extend_relay;
+    PlantRelay_t  shrink_relay;
+    uint32_t      now;                  /**< Plant time                                */
+    uint32_t      rng;                  /**< Bounce-timing generator state             */
+    uint32_t      stall_ticks;          /**< Time spent driving into an end stop       */
+    double        speed_scale;          /**< Share of the full speed (PWM duty), 1 on
+                                             relays; change only at plant time         */
+    double        hit_speed_mm_s;       /**< Highest speed of an end-stop arrival      */
+    PlantSwitch_t extend_switch;
+    PlantSwitch_t shrink_switch;
+} ActuatorPlant_t;
+
+/* -------------------------------------------------------------------------- */
+/*   API                                                                      */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Initialise the plant at a given position.
+ * @param  p_plant      Plant instance (out).
+ * @param  p_cfg        Physical parameters.
+ * @param  position_mm  Starting position, clamped to [0, stroke].
+ * @param  now          Starting tick.
+ * @param  seed         Seed for bounce timing.
+ */
+void actuator_plant_init(ActuatorPlant_t *p_plant,
+                         const ActuatorPlantConfig_t *p_cfg,
+                         double position_mm,
+                         uint32_t now,
+                         uint32_t seed);
+
+/**
+ * @brief  Apply the relay coil outputs seen at tick `now`.
+ *         Each relay contact follows its coil after `relay_delay_ms`. Both
+ *         contacts closed is treated as no drive.
+ */
+void actuator_plant_drive(ActuatorPlant_t *p_plant,
+                          uint8_t extend_on,
+                          uint8_t shrink_on);
+
+/**
+ * @brief  Return the earliest tick after the current plant time at which a
+ *         switch level or the motor drive changes, or #PLANT_NO_EVENT.
+ */
+uint32_t actuator_plant_next_event(const ActuatorPlant_t *p_plant);
+
+/**
+ * @brief  Advance the plant to tick `t` (must not be earlier than now),
+ *         applying every event on the way.
+ */
+void actuator_plant_advance(ActuatorPlant_t *p_plant, uint32_t t);
+
+#endif /* ACTUATOR_PLANT_H */
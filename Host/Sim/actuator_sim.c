@@ -0,0 +1,651 @@
+/**
+ * @file    actuator_sim.c
+ * @brief   Accelerated-time homing simulator.
+ *
+ * Runs the real actuator_update() / homing state machine against the
+ * #ActuatorPlant_t physics model with simulated ticks. Instead of stepping
+ * every millisecond, the simulator jumps from one "interesting" tick to the
+ * next: a plant event (relay takes effect, end stop reached, bounce edge) or
+ * a deadline reported by actuator_next_deadline() (debounce expiry, homing
+ * timeout, end of the midpoint move). Between those ticks actuator_update()
+ * provably does nothing, so the result is identical to a 1 ms polling loop.
+ *
+ * A homing cycle takes about 35 such steps, and a step costs about 120 ns
+ * (one actuator_update() and actuator_next_deadline(), the rest is the
+ * plant), so one core runs about 240 000 cycles — 3.6e9 simulated ticks —
+ * per second. The last output line reports the measured rates.
+ *
+ * Usage:  actuator_sim [options]
+ *   -d, --debounce RANGE      DEBOUNCE_TIME_MS values          (default 3)
+ *   -t, --timeout RANGE       HOMING_TIMEOUT_MS values         (default 10000)
+ *   -s, --stroke RANGE        stroke lengths in mm             (default 50)
+ *   -n, --cycles N            homing cycles per combination    (default 100000)
+ *   -e, --extend-speed MM_S   extend speed                     (default 10)
+ *   -r, --shrink-speed MM_S   shrink speed                     (default 10)
+ *   -R, --relay-delay MS      relay switching delay            (default 8)
+ *   -p, --spin-up MS          motor spin-up after the relay    (default 0)
+ *   -b, --bounce-ms MS        contact bounce window            (default 2)
+ *   -B, --bounces N           bounces per make / break         (default 3)
+ *   -S, --seed N              random seed                      (default 1)
+ *   -x, --exti                stop on the first switch edge (EXTI mode)
+ *   -m, --move-to PERMILLE    after homing, actuator_move_to() this position
+ *                             and report the landing error
+ *   -u, --capture             time travel from captured switch edges
+ *                             (ActuatorConfig_t::timestamp_us, as with the
+ *                             TIM3/TIM4 timebase on the target)
+ *   -g, --margin PCT          learned homing timeout margin    (default 25,
+ *                             0 = fixed HOMING_TIMEOUT_MS only)
+ *   -j, --jam                 after a clean homing, home again with the
+ *                             extend switch stuck open; a cycle counts as
+ *                             failed unless the jam ends in ACTUATOR_ERROR,
+ *                             and stall_ms is the time spent grinding first
+ *   -k, --dead-time MS        relay break-before-make gap      (default 10,
+ *                             0 = reverse at once)
+ *   -P, --park PERMILLE       where homing parks               (default 500)
+ *   -E, --encoder COUNTS_MM   quadrature encoder resolution; the controller
+ *                             positions on its count (closed loop) instead
+ *                             of on travel times                (default 0 = none)
+ *   -L, --load PCT            change both speeds by PCT after homing, so
+ *                             the move runs slower (< 0) or faster than the
+ *                             travel times measured              (default 0)
+ *   -w, --ramp ACCEL:DECEL    drive through the H-bridge with PWM ramps of
+ *                             ACCEL / DECEL ms (actuator_ramp.h, stepped
+ *                             every tick) instead of the relays
+ *   -a, --approach PERMILLE   H-bridge approach zone before an end stop
+ *                             (default 100, 0 = full speed to the stop)
+ *   -A, --approach-duty PCT   H-bridge duty in the approach zone (default 25)
+ *
+ * The controller is told the plant's stop lag (ActuatorConfig_t::stop_lag_ms
+ * = relay delay); the start lag it measures itself while homing. With
+ * --ramp the relay delay is 0, the dead time is DECEL, the stop lag
+ * DECEL / 2 and the start lag ACCEL / 2, as actuator_bridge.h recommends. hit_mm_s is the highest
+ * end-stop arrival speed of the -m move.
+ *
+ * RANGE is `value`, `first:last` or `first:last:step`. Every combination of
+ * the three swept parameters prints one result row.
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "actuator_control.h"
+#include "actuator_plant.h"
+#include "actuator_ramp.h"
+#include "main.h"                   /* Board pin map (EXTEND_CNTR_Pin, ...) */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+/** Guard against a state machine that never finishes. */
+#define SIM_MAX_STEPS_PER_CYCLE     100000U
+
+/** First simulated tick (tick 0 is reserved by the homing sequence). */
+#define SIM_START_TICK              1U
+
+/** H-bridge duty resolution: full speed in permille. */
+#define SIM_FULL_DUTY               1000U
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t s_sim_now;                  /* Tick of the update in progress */
+static uint8_t  s_sim_extend_stuck;         /* Extend switch reads open (--jam) */
+static const ActuatorPlant_t *s_p_sim_plant; /* Plant behind the encoder */
+static double   s_sim_counts_per_mm;        /* Encoder resolution (--encoder) */
+static uint8_t  s_sim_bridge;               /* H-bridge drive (--ramp) */
+static ActuatorRamp_t s_sim_ramp;           /* Its duty ramp, stepped once per tick */
+static uint8_t  s_sim_ramp_busy;            /* Ramp has not met its request yet */
+static uint64_t s_sim_steps;                /* sim_step() calls, for the rate summary */
+
+/* -------------------------------------------------------------------------- */
+/*   Types                                                                    */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    double first;
+    double last;
+    double step;
+} SimRange_t;
+
+typedef struct {
+    uint8_t  ok;                    /**< Homing finished without ACTUATOR_ERROR */
+    uint32_t extend_time;
+    uint32_t shrink_time;
+    double   park_error_mm;         /**< Final position minus the park position */
+    uint32_t stall_ticks;           /**< Time the motor drove into an end stop  */
+    double   move_error_mm;         /**< Landing position minus move-to target  */
+    double   hit_mm_s;              /**< End-stop arrival speed of the move      */
+    uint32_t sim_ticks;             /**< Simulated time of the whole cycle      */
+} SimResult_t;
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static int sim_parse_range(const char *p_text, SimRange_t *p_range)
+{
+    char *p_end = NULL;
+
+    p_range->first = strtod(p_text, &p_end);
+    p_range->last  = p_range->first;
+    p_range->step  = 1.0;
+
+    if (*p_end == ':') {
+        p_range->last = strtod(p_end + 1, &p_end);
+        if (*p_end == ':') {
+            p_range->step = strtod(p_end + 1, &p_end);
+        }
+    }
+    return ((*p_end == '\0') && (p_range->step > 0.0) && (p_range->last >= p_range->first)) ? 0 : -1;
+}
+
+static uint32_t sim_min(uint32_t a, uint32_t b)
+{
+    return (a < b) ? a : b;
+}
+
+/**
+ * @brief  Earliest tick after `now` at which actuator_update() has work to
+ *         do, given constant switch inputs.
+ */
+static uint32_t sim_actuator_deadline(const ActuatorControl_t *p_act, uint32_t now)
+{
+    const uint32_t delay = actuator_next_deadline(p_act, now);
+
+    if (delay == ACTUATOR_NO_DEADLINE) {
+        return PLANT_NO_EVENT;
+    }
+    return now + ((delay == 0U) ? 1U : delay);
+}
+
+/** Microsecond clock for ActuatorConfig_t::timestamp_us; plant events fall on ticks. */
+static uint32_t sim_timestamp_us(void)
+{
+    return s_sim_now * ACTUATOR_US_PER_TICK;
+}
+
+/** Encoder for ActuatorConfig_t::encoder_count: whole counts of the plant position. */
+static int32_t sim_encoder_count(void)
+{
+    return (int32_t)floor(s_p_sim_plant->position_mm * s_sim_counts_per_mm);
+}
+
+/** Extend switch contact as wired, i.e. open while it is stuck. */
+static uint8_t sim_extend_closed(const ActuatorPlant_t *p_plant)
+{
+    return (s_sim_extend_stuck != 0U) ? 0U : p_plant->extend_switch.closed;
+}
+
+static void sim_apply_inputs(const ActuatorPlant_t *p_plant)
+{
+    host_gpio_set_input(EXTEND_SWITCH_GPIO_Port, EXTEND_SWITCH_Pin,
+                        (GPIO_PinState)sim_extend_closed(p_plant));
+    host_gpio_set_input(SHRINK_SWITCH_GPIO_Port, SHRINK_SWITCH_Pin,
+                        (GPIO_PinState)p_plant->shrink_switch.closed);
+}
+
+/** H-bridge for ActuatorConfig_t::bridge_output: the ramp takes it from here. */
+static void sim_bridge_output(ActuatorOutput_t output, ActuatorSpeed_t speed)
+{
+    actuator_ramp_set(&s_sim_ramp, output, speed);
+    s_sim_ramp_busy = 1U;
+}
+
+static void sim_apply_outputs(ActuatorPlant_t *p_plant)
+{
+    if (s_sim_bridge != 0U) {
+        p_plant->speed_scale = (double)s_sim_ramp.duty / (double)SIM_FULL_DUTY;
+        actuator_plant_drive(p_plant,
+                             (uint8_t)(s_sim_ramp.direction == ACTUATOR_OUTPUT_EXTEND),
+                             (uint8_t)(s_sim_ramp.direction == ACTUATOR_OUTPUT_SHRINK));
+        return;
+    }
+
+    const uint32_t odr = host_gpio_get_output(EXTEND_CNTR_GPIO_Port);
+
+    actuator_plant_drive(p_plant,
+                         (uint8_t)((odr & EXTEND_CNTR_Pin) != 0U),
+                         (uint8_t)((odr & SHRINK_CNTR_Pin) != 0U));
+}
+
+/**
+ * @brief  Let the motor come to rest after the state machine has finished:
+ *         through the relay release, or through the H-bridge ramp-down.
+ */
+static void sim_settle(ActuatorPlant_t *p_plant)
+{
+    while (s_sim_ramp_busy != 0U) {
+        sim_apply_outputs(p_plant);
+        actuator_plant_advance(p_plant, p_plant->now + 1U);
+        s_sim_ramp_busy = actuator_ramp_step(&s_sim_ramp);
+    }
+    sim_apply_outputs(p_plant);
+    actuator_plant_advance(p_plant, p_plant->now + p_plant->config.relay_delay_ms);
+}
+
+/**
+ * @brief  Raise the EXTI handler for every switch whose raw level changed,
+ *         and the input capture for every closing edge.
+ */
+static void sim_raise_edges(ActuatorControl_t *p_act, const ActuatorPlant_t *p_plant,
+                            uint8_t use_exti, uint8_t use_capture,
+                            uint8_t *p_prev_extend, uint8_t *p_prev_shrink)
+{
+    if (sim_extend_closed(p_plant) != *p_prev_extend) {
+        *p_prev_extend = sim_extend_closed(p_plant);
+        if (use_exti != 0U) {
+            actuator_limit_switch_isr(p_act, EXTEND_SWITCH_Pin);
+        }
+        if ((use_capture != 0U) && (*p_prev_extend != 0U)) {
+            actuator_switch_edge(p_act, EXTEND_SWITCH_Pin, p_plant->now * ACTUATOR_US_PER_TICK);
+        }
+    }
+    if (p_plant->shrink_switch.closed != *p_prev_shrink) {
+        *p_prev_shrink = p_plant->shrink_switch.closed;
+        if (use_exti != 0U) {
+            actuator_limit_switch_isr(p_act, SHRINK_SWITCH_Pin);
+        }
+        if ((use_capture != 0U) && (*p_prev_shrink != 0U)) {
+            actuator_switch_edge(p_act, SHRINK_SWITCH_Pin, p_plant->now * ACTUATOR_US_PER_TICK);
+        }
+    }
+}
+
+/**
+ * @brief  Advance plant and state machine to the next interesting tick.
+ */
+static void sim_step(ActuatorControl_t *p_act, ActuatorPlant_t *p_plant, uint8_t use_exti,
+                     uint32_t *p_now, uint8_t *p_prev_extend, uint8_t *p_prev_shrink)
+{
+    const uint8_t use_capture = (p_act->config.timestamp_us != NULL) ? 1U : 0U;
+
+    s_sim_steps++;
+    sim_apply_outputs(p_plant);
+
+    *p_now = sim_min(sim_min(actuator_plant_next_event(p_plant), sim_actuator_deadline(p_act, *p_now)),
+                     (s_sim_ramp_busy != 0U) ? (*p_now + 1U) : PLANT_NO_EVENT);
+
+    actuator_plant_advance(p_plant, *p_now);
+    if (s_sim_ramp_busy != 0U) {
+        s_sim_ramp_busy = actuator_ramp_step(&s_sim_ramp);
+    }
+    sim_apply_inputs(p_plant);
+    sim_raise_edges(p_act, p_plant, use_exti, use_capture, p_prev_extend, p_prev_shrink);
+    s_sim_now = *p_now;
+    actuator_update(p_act, *p_now);
+}
+
+/**
+ * @brief  Home again with the extend switch stuck open, from where the
+ *         previous homing parked. Ends when the state machine gives up.
+ */
+static SimResult_t sim_run_jam(ActuatorControl_t *p_act, ActuatorPlant_t *p_plant,
+                               uint8_t use_exti, uint32_t now,
+                               uint8_t *p_prev_extend, uint8_t *p_prev_shrink)
+{
+    SimResult_t result = { 0U, 0U, 0U, 0.0, 0U, 0.0, 0.0, 0U };
+
+    s_sim_extend_stuck   = 1U;
+    p_plant->stall_ticks = 0U;
+
+    s_sim_now = now;
+    actuator_start_homing(p_act);
+    actuator_update(p_act, now);
+
+    for (uint32_t steps = 0U; (p_act->is_homing != 0U) && (steps < SIM_MAX_STEPS_PER_CYCLE); steps++) {
+        sim_step(p_act, p_plant, use_exti, &now, p_prev_extend, p_prev_shrink);
+    }
+
+    sim_settle(p_plant);
+    s_sim_extend_stuck = 0U;
+
+    result.ok          = actuator_is_error(p_act);
+    result.stall_ticks = p_plant->stall_ticks;
+    result.sim_ticks   = p_plant->now - SIM_START_TICK;
+    return result;
+}
+
+/**
+ * @brief  Run one complete homing sequence from a random start position,
+ *         optionally followed by a move to `move_to` permille, or by a
+ *         jammed homing (#sim_run_jam()).
+ */
+static SimResult_t sim_run_cycle(const ActuatorConfig_t *p_act_cfg,
+                                 const ActuatorPlantConfig_t *p_plant_cfg,
+                                 uint8_t use_exti,
+                                 uint16_t move_to,
+                                 uint8_t jam,
+                                 double load_pct,
+                                 uint32_t seed)
+{
+    ActuatorControl_t act;
+    ActuatorPlant_t   plant;
+    SimResult_t       result = { 0U, 0U, 0U, 0.0, 0U, 0.0, 0.0, 0U };
+    uint32_t          now    = SIM_START_TICK;
+
+    /* Random but reproducible start position */
+    const double start = p_plant_cfg->stroke_mm * (double)(seed % 1001U) / 1000.0;
+
+    const ActuatorRampConfig_t ramp_cfg = s_sim_ramp.config;
+
+    host_hal_reset();
+    (void)actuator_ramp_init(&s_sim_ramp, &ramp_cfg);
+    s_sim_ramp_busy = 0U;
+    actuator_plant_init(&plant, p_plant_cfg, start, now, seed);
+    s_p_sim_plant = &plant;
+    actuator_init(&act, p_act_cfg);
+    sim_apply_inputs(&plant);
+
+    uint8_t prev_extend = plant.extend_switch.closed;
+    uint8_t prev_shrink = plant.shrink_switch.closed;
+
+    s_sim_now = now;
+    actuator_start_homing(&act);
+    actuator_update(&act, now);
+
+    for (uint32_t steps = 0U; (act.is_homing != 0U) && (steps < SIM_MAX_STEPS_PER_CYCLE); steps++) {
+        sim_step(&act, &plant, use_exti, &now, &prev_extend, &prev_shrink);
+    }
+
+    /* Let the motor coast through the relay release; the next command
+       is issued at the same time in both */
+    sim_settle(&plant);
+    now = plant.now;
+
+    result.ok            = (uint8_t)((act.is_homing == 0U) && !actuator_is_error(&act));
+    result.extend_time   = act.extend_time;
+    result.shrink_time   = act.shrink_time;
+    result.park_error_mm = plant.position_mm -
+                           (p_plant_cfg->stroke_mm * (double)p_act_cfg->park_position /
+                            (double)ACTUATOR_POSITION_MAX);
+    result.stall_ticks   = plant.stall_ticks;
+
+    if (jam != 0U) {
+        return (result.ok != 0U) ? sim_run_jam(&act, &plant, use_exti, now, &prev_extend, &prev_shrink)
+                                 : result;
+    }
+
+    if ((result.ok != 0U) && (move_to != ACTUATOR_POSITION_UNKNOWN)) {
+        plant.config.extend_speed_mm_s *= 1.0 + (load_pct / 100.0);
+        plant.config.shrink_speed_mm_s *= 1.0 + (load_pct / 100.0);
+        plant.hit_speed_mm_s = 0.0;
+        actuator_move_to(&act, move_to);
+        actuator_update(&act, now);
+
+        for (uint32_t steps = 0U;
+             (actuator_get_state(&act) != ACTUATOR_IDLE) && (steps < SIM_MAX_STEPS_PER_CYCLE);
+             steps++) {
+            sim_step(&act, &plant, use_exti, &now, &prev_extend, &prev_shrink);
+        }
+
+        sim_settle(&plant);
+
+        result.hit_mm_s      = plant.hit_speed_mm_s;
+        result.move_error_mm = plant.position_mm -
+                               (p_plant_cfg->stroke_mm * (double)move_to / (double)ACTUATOR_POSITION_MAX);
+        result.stall_ticks   = plant.stall_ticks;
+    }
+    result.sim_ticks = plant.now - SIM_START_TICK;
+    return result;
+}
+
+static void sim_usage(const char *p_name)
+{
+    fprintf(stderr,
+            "usage: %s [-d RANGE] [-t RANGE] [-s RANGE] [-n cycles] [-e mm/s] [-r mm/s]\n"
+            "          [-R relay_ms] [-b bounce_ms] [-B bounces] [-S seed] [-x] [-m permille] [-u]\n"
+            "          [-g margin_pct] [-j] [-k dead_ms] [-p spinup_ms] [-P park_permille]\n"
+            "          [-E counts_per_mm] [-L load_pct] [-w accel_ms:decel_ms] [-a permille]\n"
+            "          [-A approach_pct]\n",
+            p_name);
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    SimRange_t debounce = { DEBOUNCE_TIME_MS,  DEBOUNCE_TIME_MS,  1.0 };
+    SimRange_t timeout  = { HOMING_TIMEOUT_MS, HOMING_TIMEOUT_MS, 1.0 };
+    SimRange_t stroke   = { 50.0, 50.0, 1.0 };
+    unsigned long cycles = 100000UL;
+    uint32_t      seed   = 1U;
+    uint8_t       exti   = 0U;
+    uint16_t      move   = ACTUATOR_POSITION_UNKNOWN;
+    uint8_t       capture = 0U;
+    uint16_t      margin  = HOMING_TIMEOUT_MARGIN_PERCENT;
+    uint8_t       jam     = 0U;
+    uint32_t      dead    = RELAY_DEAD_TIME_MS;
+    uint16_t      park    = ACTUATOR_PARK_POSITION;
+    double        load    = 0.0;
+    unsigned      accel   = 0U;
+    unsigned      decel   = 0U;
+    uint16_t      approach     = ACTUATOR_APPROACH_PERMILLE;
+    unsigned      approach_pct = ACTUATOR_BRIDGE_APPROACH_PCT;
+
+    ActuatorPlantConfig_t plant_cfg = {
+        .stroke_mm         = 50.0,
+        .extend_speed_mm_s = 10.0,
+        .shrink_speed_mm_s = 10.0,
+        .relay_delay_ms    = 8U,
+        .spinup_ms         = 0U,
+        .bounce_ms         = 2U,
+        .bounces           = 3U
+    };
+
+    static const struct option s_options[] = {
+        { "debounce",     required_argument, NULL, 'd' },
+        { "timeout",      required_argument, NULL, 't' },
+        { "stroke",       required_argument, NULL, 's' },
+        { "cycles",       required_argument, NULL, 'n' },
+        { "extend-speed", required_argument, NULL, 'e' },
+        { "shrink-speed", required_argument, NULL, 'r' },
+        { "relay-delay",  required_argument, NULL, 'R' },
+        { "bounce-ms",    required_argument, NULL, 'b' },
+        { "bounces",      required_argument, NULL, 'B' },
+        { "seed",         required_argument, NULL, 'S' },
+        { "exti",         no_argument,       NULL, 'x' },
+        { "move-to",      required_argument, NULL, 'm' },
+        { "capture",      no_argument,       NULL, 'u' },
+        { "margin",       required_argument, NULL, 'g' },
+        { "jam",          no_argument,       NULL, 'j' },
+        { "dead-time",    required_argument, NULL, 'k' },
+        { "spin-up",      required_argument, NULL, 'p' },
+        { "park",         required_argument, NULL, 'P' },
+        { "encoder",      required_argument, NULL, 'E' },
+        { "load",         required_argument, NULL, 'L' },
+        { "ramp",         required_argument, NULL, 'w' },
+        { "approach",     required_argument, NULL, 'a' },
+        { "approach-duty", required_argument, NULL, 'A' },
+        { NULL,           0,                 NULL, 0   }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "d:t:s:n:e:r:R:b:B:S:xm:ug:jk:p:P:E:L:w:a:A:", s_options, NULL)) != -1) {
+        int bad = 0;
+        switch (opt) {
+            case 'd': bad = sim_parse_range(optarg, &debounce);                  break;
+            case 't': bad = sim_parse_range(optarg, &timeout);                   break;
+            case 's': bad = sim_parse_range(optarg, &stroke);                    break;
+            case 'n': cycles                   = strtoul(optarg, NULL, 0);       break;
+            case 'e': plant_cfg.extend_speed_mm_s = strtod(optarg, NULL);        break;
+            case 'r': plant_cfg.shrink_speed_mm_s = strtod(optarg, NULL);        break;
+            case 'R': plant_cfg.relay_delay_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'b': plant_cfg.bounce_ms      = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'B': plant_cfg.bounces        = (uint8_t)strtoul(optarg, NULL, 0);  break;
+            case 'S': seed                     = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'x': exti                     = 1U;                                 break;
+            case 'm': move                     = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'u': capture                  = 1U;                                 break;
+            case 'g': margin                   = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'j': jam                      = 1U;                                 break;
+            case 'k': dead                     = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': plant_cfg.spinup_ms      = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'P': park                     = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'E': s_sim_counts_per_mm      = strtod(optarg, NULL);           break;
+            case 'L': load                     = strtod(optarg, NULL);           break;
+            case 'w': bad = (sscanf(optarg, "%u:%u", &accel, &decel) == 2) ? 0 : -1;
+                      s_sim_bridge             = 1U;                                 break;
+            case 'a': approach                 = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'A': approach_pct             = (unsigned)strtoul(optarg, NULL, 0); break;
+            default:  bad = -1;                                                   break;
+        }
+        if (bad != 0) {
+            sim_usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((cycles == 0UL) || (plant_cfg.extend_speed_mm_s <= 0.0) || (plant_cfg.shrink_speed_mm_s <= 0.0) ||
+        ((move != ACTUATOR_POSITION_UNKNOWN) && (move > ACTUATOR_POSITION_MAX)) ||
+        (park > ACTUATOR_POSITION_MAX) || (s_sim_counts_per_mm < 0.0) || (load <= -100.0) ||
+        (accel > 0xFFFFU) || (decel > 0xFFFFU) || (approach > ACTUATOR_POSITION_MAX) ||
+        (approach_pct > 100U)) {
+        sim_usage(argv[0]);
+        return 1;
+    }
+
+    /* One ramp step per tick; a bridge switches without relay delay, the
+       ramp-down is the dead time and its travel the stop lag */
+    const ActuatorRampConfig_t ramp_cfg = {
+        .full_duty     = SIM_FULL_DUTY,
+        .approach_duty = (uint16_t)((SIM_FULL_DUTY * approach_pct) / 100U),
+        .accel_ms      = (uint16_t)accel,
+        .decel_ms      = (uint16_t)decel,
+        .step_hz       = 1000U
+    };
+    (void)actuator_ramp_init(&s_sim_ramp, &ramp_cfg);
+    if (s_sim_bridge != 0U) {
+        plant_cfg.relay_delay_ms = 0U;
+        dead                     = decel;
+    }
+
+    printf("# extend %.2f mm/s, shrink %.2f mm/s, relay %u ms, spin-up %u ms, dead time %u ms, "
+           "bounce %u x %u ms, park %u permille, %s%s%s, encoder %.1f counts/mm, load %+.0f %%, "
+           "%lu cycles/row\n",
+           plant_cfg.extend_speed_mm_s, plant_cfg.shrink_speed_mm_s,
+           (unsigned)plant_cfg.relay_delay_ms, (unsigned)plant_cfg.spinup_ms, (unsigned)dead,
+           (unsigned)plant_cfg.bounces, (unsigned)plant_cfg.bounce_ms, (unsigned)park,
+           (exti != 0U) ? "exti" : "polled",
+           (capture != 0U) ? ", edge-timed" : "", (jam != 0U) ? ", jammed re-homing" : "",
+           s_sim_counts_per_mm, load, cycles);
+    if (s_sim_bridge != 0U) {
+        printf("# H-bridge: accel %u ms, decel %u ms, approach %u permille at %u %% duty\n",
+               accel, decel, (unsigned)approach, approach_pct);
+    }
+    printf("%8s %8s %8s %8s %12s %12s %12s %12s %12s %10s %10s %10s\n",
+           "debounce", "timeout", "stroke", "failed", "extend_ms", "shrink_ms",
+           "park_mm", "max|park|", "max|move|", "stall_ms", "hit_mm_s", "cycles/s");
+
+    double total_cycles  = 0.0;
+    double total_ticks   = 0.0;
+    double total_elapsed = 0.0;
+
+    for (double d = debounce.first; d <= debounce.last; d += debounce.step) {
+        for (double t = timeout.first; t <= timeout.last; t += timeout.step) {
+            for (double s = stroke.first; s <= stroke.last; s += stroke.step) {
+                const ActuatorConfig_t act_cfg = {
+                    .extend_active_level = GPIO_PIN_SET,
+                    .shrink_active_level = GPIO_PIN_SET,
+                    .debounce_time_ms    = MS_TO_TICKS((uint32_t)d),
+                    .homing_timeout_ms   = MS_TO_TICKS((uint32_t)t),
+                    .homing_margin_pct   = margin,
+                    .relay_dead_time_ms  = MS_TO_TICKS(dead),
+                    .stop_lag_ms         = MS_TO_TICKS((s_sim_bridge != 0U) ? (decel / 2U)
+                                                                         : plant_cfg.relay_delay_ms),
+                    .start_lag_ms        = MS_TO_TICKS((s_sim_bridge != 0U) ? (accel / 2U) : 0U),
+                    .park_position       = park,
+                    /* Every plant event is followed by an update, so the
+                       switches never need per-tick polling here */
+                    .switch_edge_wakeup  = 1U,
+                    .timestamp_us        = (capture != 0U) ? sim_timestamp_us : NULL,
+                    .encoder_count       = (s_sim_counts_per_mm > 0.0) ? sim_encoder_count : NULL,
+                    .approach_permille   = approach,
+                    .bridge_output       = (s_sim_bridge != 0U) ? sim_bridge_output : NULL,
+
+                    .extend_control_port = (s_sim_bridge != 0U) ? NULL : (void*)EXTEND_CNTR_GPIO_Port,
+                    .extend_control_pin  = EXTEND_CNTR_Pin,
+                    .shrink_control_port = (s_sim_bridge != 0U) ? NULL : (void*)SHRINK_CNTR_GPIO_Port,
+                    .shrink_control_pin  = SHRINK_CNTR_Pin,
+                    .extend_switch_port  = (void*)EXTEND_SWITCH_GPIO_Port,
+                    .extend_switch_pin   = EXTEND_SWITCH_Pin,
+                    .shrink_switch_port  = (void*)SHRINK_SWITCH_GPIO_Port,
+                    .shrink_switch_pin   = SHRINK_SWITCH_Pin,
+                    .led_extend_port     = (void*)LED_EXTEND_GPIO_Port,
+                    .led_extend_pin      = LED_EXTEND_Pin,
+                    .led_shrink_port     = (void*)LED_SHRINK_GPIO_Port,
+                    .led_shrink_pin      = LED_SHRINK_Pin
+                };
+                plant_cfg.stroke_mm = s;
+
+                unsigned long failed     = 0UL;
+                double        sum_extend = 0.0;
+                double        sum_shrink = 0.0;
+                double        sum_park   = 0.0;
+                double        max_park   = 0.0;
+                double        max_move   = 0.0;
+                double        sum_stall  = 0.0;
+                double        max_hit    = 0.0;
+
+                struct timespec t0;
+                struct timespec t1;
+                clock_gettime(CLOCK_MONOTONIC, &t0);
+
+                for (unsigned long c = 0UL; c < cycles; c++) {
+                    const SimResult_t r = sim_run_cycle(&act_cfg, &plant_cfg, exti, move, jam, load,
+                                                        (seed * 2654435761U) + (uint32_t)c);
+                    total_ticks += (double)r.sim_ticks;
+                    if (r.ok == 0U) {
+                        failed++;
+                        continue;
+                    }
+                    sum_extend += (double)r.extend_time;
+                    sum_shrink += (double)r.shrink_time;
+                    sum_park   += r.park_error_mm;
+                    sum_stall  += (double)r.stall_ticks;
+                    if (fabs(r.park_error_mm) > max_park) {
+                        max_park = fabs(r.park_error_mm);
+                    }
+                    if (fabs(r.move_error_mm) > max_move) {
+                        max_move = fabs(r.move_error_mm);
+                    }
+                    if (r.hit_mm_s > max_hit) {
+                        max_hit = r.hit_mm_s;
+                    }
+                }
+
+                clock_gettime(CLOCK_MONOTONIC, &t1);
+                const double elapsed = (double)(t1.tv_sec - t0.tv_sec) +
+                                       ((double)(t1.tv_nsec - t0.tv_nsec) * 1e-9);
+                const double ok = (double)(cycles - failed);
+
+                total_cycles  += (double)cycles;
+                total_elapsed += elapsed;
+
+                printf("%8u %8u %8.1f %8lu %12.1f %12.1f %12.3f %12.3f %12.3f %10.1f %10.2f %10.0f\n",
+                       (unsigned)d, (unsigned)t, s, failed,
+                       (ok > 0.0) ? (sum_extend / ok) : 0.0,
+                       (ok > 0.0) ? (sum_shrink / ok) : 0.0,
+                       (ok > 0.0) ? (sum_park / ok) : 0.0,
+                       max_park,
+                       max_move,
+                       (ok > 0.0) ? (sum_stall / ok) : 0.0,
+                       max_hit,
+                       (elapsed > 0.0) ? ((double)cycles / elapsed) : 0.0);
+            }
+        }
+    }
+
+    /* Throughput in simulated time, and what one step costs */
+    if ((total_elapsed > 0.0) && (s_sim_steps > 0U)) {
+        printf("# %.0f homing cycles/s, %.3g simulated ticks/s, %.1f steps/cycle at %.0f ns/step\n",
+               total_cycles / total_elapsed, total_ticks / total_elapsed,
+               (double)s_sim_steps / total_cycles, (total_elapsed * 1e9) / (double)s_sim_steps);
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+/**
+ * @file    stm32f1xx_hal_host.c
+ * @brief   Host (Linux) implementation of the HAL stand-in.
+ *
+ * HAL writes go straight to ODR. Direct BSRR / BRR stores cannot be trapped
+ * on the host, so they are latched into ODR the next time the port is
+ * observed (see host_gpio_latch()). Code under test must therefore write a
+ * complete set/reset word per store — which is what set_outputs() does.
+ *
+ * The calibration page the linker script reserves on the target is a
+ * FLASH_PAGE_SIZE block of .data here, between the same two symbols.
+ */
+
+#include "stm32f1xx_hal.h"
+
+#include <string.h>
+
+/* ---- `_calib_start` / `_calib_end`, one page apart (1024 = FLASH_PAGE_SIZE) ---- */
+__asm__("    .data\n"
+        "    .balign 4\n"
+        "    .globl _calib_start\n"
+        "_calib_start:\n"
+        "    .fill 1024, 1, 0xFF\n"
+        "    .globl _calib_end\n"
+        "_calib_end:\n"
+        "    .previous\n");
+
+extern uint32_t _calib_start;
+extern uint32_t _calib_end;
+
+#define HOST_FLASH_START    ((uintptr_t)&_calib_start)
+#define HOST_FLASH_END      ((uintptr_t)&_calib_end)
+
+GPIO_TypeDef host_gpio_ports[HOST_GPIO_PORT_COUNT];
+
+static uint32_t s_host_tick;
+static uint8_t  s_flash_locked = 1U;
+static uint32_t s_flash_erases;
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Apply pending BSRR / BRR stores to ODR. Set wins over reset, as
+ *         on the real peripheral.
+ */
+static void host_gpio_latch(GPIO_TypeDef *GPIOx)
+{
+    const uint32_t bsrr = GPIOx->BSRR;
+    const uint32_t brr  = GPIOx->BRR;
+
+    if ((bsrr | brr) != 0U) {
+        GPIOx->ODR  = (GPIOx->ODR & ~((bsrr >> 16U) | brr)) | (bsrr & 0xFFFFU);
+        GPIOx->BSRR = 0U;
+        GPIOx->BRR  = 0U;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*   GPIO                                                                     */
+/* -------------------------------------------------------------------------- */
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->IDR & GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    host_gpio_latch(GPIOx);
+
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Tick                                                                     */
+/* -------------------------------------------------------------------------- */
+
+uint32_t HAL_GetTick(void)
+{
+    return s_host_tick;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Flash                                                                    */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief  Program one half-word: allowed on an erased half-word, or to
+ *         clear any half-word to zero, as on the F103.
+ */
+static HAL_StatusTypeDef host_flash_program_half(uintptr_t address, uint16_t data)
+{
+    if ((address < HOST_FLASH_START) || ((address + 2U) > HOST_FLASH_END) || ((address & 1U) != 0U)) {
+        return HAL_ERROR;
+    }
+
+    uint16_t current;
+
+    memcpy(&current, (const void*)address, sizeof(current));
+    if ((current != 0xFFFFU) && (data != 0U)) {
+        return HAL_ERROR;                       /* PGERR */
+    }
+    memcpy((void*)address, &data, sizeof(data));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    s_flash_locked = 0U;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    s_flash_locked = 1U;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uintptr_t Address, uint64_t Data)
+{
+    const uint32_t halves = (TypeProgram == FLASH_TYPEPROGRAM_WORD) ? 2U : 1U;
+
+    if (s_flash_locked != 0U) {
+        return HAL_ERROR;
+    }
+    for (uint32_t i = 0U; i < halves; i++) {
+        const HAL_StatusTypeDef status =
+            host_flash_program_half(Address + (2U * i), (uint16_t)(Data >> (16U * i)));
+        if (status != HAL_OK) {
+            return status;
+        }
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError)
+{
+    const uintptr_t end = pEraseInit->PageAddress + ((uintptr_t)pEraseInit->NbPages * FLASH_PAGE_SIZE);
+
+    *PageError = 0xFFFFFFFFU;
+    if ((s_flash_locked != 0U) || (pEraseInit->TypeErase != FLASH_TYPEERASE_PAGES) ||
+        (pEraseInit->PageAddress < HOST_FLASH_START) || (end > HOST_FLASH_END)) {
+        *PageError = (uint32_t)pEraseInit->PageAddress;
+        return HAL_ERROR;
+    }
+    memset((void*)pEraseInit->PageAddress, 0xFF, end - pEraseInit->PageAddress);
+    s_flash_erases += pEraseInit->NbPages;
+    return HAL_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Host-only helpers                                                        */
+/* -------------------------------------------------------------------------- */
+
+void host_hal_reset(void)
+{
+    memset((void*)host_gpio_ports, 0, sizeof(host_gpio_ports));
+    memset((void*)HOST_FLASH_START, 0xFF, HOST_FLASH_END - HOST_FLASH_START);
+    s_host_tick    = 0U;
+    s_flash_locked = 1U;
+    s_flash_erases = 0U;
+}
+
+void host_hal_set_tick(uint32_t tick)
+{
+    s_host_tick = tick;
+}
+
+void host_gpio_set_input(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->IDR |= GPIO_Pin;
+    } else {
+        GPIOx->IDR &= ~(uint32_t)GPIO_Pin;
+    }
+}
+
+uint32_t host_gpio_get_output(GPIO_TypeDef *GPIOx)
+{
+    host_gpio_latch(GPIOx);
+    return GPIOx->ODR;
+}
+
+uint32_t host_flash_erase_count(void)
+{
+    return s_flash_erases;
+}
+
+void *host_flash_page(void)
+{
+    return (void*)HOST_FLASH_START;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file    actuator_group_test.c
+ * @brief   Host test of the EXTI end stop in an ActuatorGroup_t.
+ *
+ * One actuator extends, its extend switch closes and the EXTI handler cuts
+ * the relay at once. The relay must stay released while the switch is
+ * closed — steadily or bouncing — until the debounced stop ends the move.
+ * A one-tick glitch, on the other hand, must resume the move once the
+ * switch has read open for a full debounce window.
+ *
+ * Usage:  actuator_group_test       (exit status 0 if every case passes)
+ */
+
+#include <stdio.h>
+
+#include "actuator_control.h"
+#include "actuator_group.h"
+#include "main.h"                   /* Board pin map (EXTEND_CNTR_Pin, ...) */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+#define TEST_RELAY_PIN      GPIO_PIN_0          /**< Extend relay on GPIOA    */
+#define TEST_SWITCH_PIN     GPIO_PIN_0          /**< Extend switch on GPIOB   */
+#define TEST_HIT_TICK       10U                 /**< Switch closes here       */
+#define TEST_END_TICK       40U
+
+/* -------------------------------------------------------------------------- */
+/*   Private functions                                                        */
+/* -------------------------------------------------------------------------- */
+
+static void test_group_init(ActuatorGroup_t *p_group)
+{
+    const ActuatorConfig_t cfg = {
+        .extend_active_level = GPIO_PIN_SET,
+        .shrink_active_level = GPIO_PIN_SET,
+        .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+        .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+        .homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT,
+        .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+        .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+        .park_position       = ACTUATOR_PARK_POSITION,
+
+        .extend_control_port = (void*)GPIOA,
+        .extend_control_pin  = TEST_RELAY_PIN,
+        .shrink_control_port = (void*)GPIOA,
+        .shrink_control_pin  = GPIO_PIN_1,
+        .extend_switch_port  = (void*)GPIOB,
+        .extend_switch_pin   = TEST_SWITCH_PIN,
+        .shrink_switch_port  = (void*)GPIOB,
+        .shrink_switch_pin   = GPIO_PIN_1,
+        .led_extend_port     = (void*)GPIOA,
+        .led_extend_pin      = GPIO_PIN_2,
+        .led_shrink_port     = (void*)GPIOA,
+        .led_shrink_pin      = GPIO_PIN_3
+    };
+
+    host_hal_reset();
+    (void)actuator_group_init(p_group, &cfg, 1U);
+    actuator_extend(actuator_group_get(p_group, 0U));
+}
+
+static uint8_t test_relay_on(void)
+{
+    return ((host_gpio_get_output(GPIOA) & TEST_RELAY_PIN) != 0U) ? 1U : 0U;
+}
+
+/**
+ * @brief  Extend, close the switch at #TEST_HIT_TICK through EXTI and fail
+ *         if the relay is ever energised again.
+ * @param  name     Case name for the report.
+ * @param  bounces  Ticks after the hit during which the contact alternates.
+ * @return Non-zero if the case failed.
+ */
+static int test_exti_stop_holds(const char *name, uint32_t bounces)
+{
+    ActuatorGroup_t group;
+    int             failed = 0;
+
+    test_group_init(&group);
+
+    for (uint32_t t = 1U; t < TEST_END_TICK; t++) {
+        if (t >= TEST_HIT_TICK) {
+            const uint32_t since  = t - TEST_HIT_TICK;
+            const uint8_t  closed = ((since >= bounces) || ((since & 1U) == 0U)) ? 1U : 0U;
+
+            host_gpio_set_input(GPIOB, TEST_SWITCH_PIN, closed ? GPIO_PIN_SET : GPIO_PIN_RESET);
+            if (t == TEST_HIT_TICK) {
+                actuator_group_limit_switch_isr(&group, TEST_SWITCH_PIN);
+            }
+        }
+        host_hal_set_tick(t);
+        actuator_group_update(&group, t);
+
+        if (t < TEST_HIT_TICK) {
+            if (test_relay_on() == 0U) {
+                printf("%s: relay off at t=%u before the stop\n", name, (unsigned)t);
+                failed = 1;
+            }
+        } else if (test_relay_on() != 0U) {
+            printf("%s: relay on at t=%u with the switch closed\n", name, (unsigned)t);
+            failed = 1;
+        }
+    }
+    if (actuator_get_state(actuator_group_get(&group, 0U)) == ACTUATOR_EXTENDING) {
+        printf("%s: still extending at t=%u\n", name, (unsigned)TEST_END_TICK);
+        failed = 1;
+    }
+    return failed;
+}
+
+/**
+ * @brief  A single-tick closure is a glitch: the relay comes back on and
+ *         the actuator keeps extending.
+ * @return Non-zero if the case failed.
+ */
+static int test_exti_glitch_resumes(void)
+{
+    ActuatorGroup_t group;
+
+    test_group_init(&group);
+
+    for (uint32_t t = 1U; t < TEST_END_TICK; t++) {
+        host_gpio_set_input(GPIOB, TEST_SWITCH_PIN,
+                            (t == TEST_HIT_TICK) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        if (t == TEST_HIT_TICK) {
+            actuator_group_limit_switch_isr(&group, TEST_SWITCH_PIN);
+        }
+        host_hal_set_tick(t);
+        actuator_group_update(&group, t);
+    }
+    if ((test_relay_on() == 0U) ||
+        (actuator_get_state(actuator_group_get(&group, 0U)) != ACTUATOR_EXTENDING)) {
+        printf("glitch: move not resumed by t=%u\n", (unsigned)TEST_END_TICK);
+        return 1;
+    }
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(void)
+{
+    int failed = 0;
+
+    failed |= test_exti_stop_holds("closed", 0U);
+    failed |= test_exti_stop_holds("bounce", 5U);
+    failed |= test_exti_glitch_resumes();
+
+    printf("actuator_group_test: %s\n", (failed != 0) ? "FAILED" : "passed");
+    return failed;
+}
@@ -0,0 +1,269 @@
+/**
+ * @file    actuator_storage_test.c
+ * @brief   Host test of the calibration log and the boot decision.
+ *
+ * Runs actuator_storage.c against the RAM-backed flash page of the HAL
+ * stand-in. Every case starts from an erased page and checks what
+ * actuator_storage_load() reports at the next boot: only
+ * #ACTUATOR_STORAGE_OK lets main.c skip homing.
+ *
+ * Usage:  actuator_storage_test     (exit status 0 if every case passes)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "actuator_control.h"
+#include "actuator_storage.h"
+#include "main.h"                   /* Board pin map (EXTEND_CNTR_Pin, ...) */
+
+/* -------------------------------------------------------------------------- */
+/*   Private constants                                                        */
+/* -------------------------------------------------------------------------- */
+
+#define TEST_EXTEND_TIME    4200U
+#define TEST_SHRINK_TIME    3900U
+#define TEST_POSITION       500U
+
+/** Records that fit the page before it has to be erased. */
+#define TEST_PAGE_SLOTS     (FLASH_PAGE_SIZE / sizeof(ActuatorCalibRecord_t))
+
+/* -------------------------------------------------------------------------- */
+/*   Private functions                                                        */
+/* -------------------------------------------------------------------------- */
+
+static void test_actuator_init(ActuatorControl_t *p_act)
+{
+    const ActuatorConfig_t cfg = {
+        .extend_active_level = GPIO_PIN_SET,
+        .shrink_active_level = GPIO_PIN_SET,
+        .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+        .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+        .homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT,
+        .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+        .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+        .park_position       = ACTUATOR_PARK_POSITION,
+
+        .extend_control_port = (void*)GPIOA,
+        .extend_control_pin  = GPIO_PIN_0,
+        .shrink_control_port = (void*)GPIOA,
+        .shrink_control_pin  = GPIO_PIN_1,
+        .extend_switch_port  = (void*)GPIOB,
+        .extend_switch_pin   = GPIO_PIN_0,
+        .shrink_switch_port  = (void*)GPIOB,
+        .shrink_switch_pin   = GPIO_PIN_1,
+        .led_extend_port     = (void*)GPIOA,
+        .led_extend_pin      = GPIO_PIN_2,
+        .led_shrink_port     = (void*)GPIOA,
+        .led_shrink_pin      = GPIO_PIN_3
+    };
+
+    actuator_init(p_act, &cfg);
+}
+
+/**
+ * @brief  Save one record of a calibrated actuator at `position`.
+ * @return Status of actuator_storage_save().
+ */
+static ActuatorStorageStatus_t test_save(ActuatorStorage_t *p_store, uint16_t position)
+{
+    ActuatorControl_t act;
+
+    test_actuator_init(&act);
+    actuator_restore_calibration(&act, TEST_EXTEND_TIME, TEST_SHRINK_TIME, position);
+    return actuator_storage_save(p_store, &act);
+}
+
+/**
+ * @brief  Boot: load into a fresh actuator.
+ * @param  p_act  Actuator to restore into (out).
+ * @return Status of actuator_storage_load().
+ */
+static ActuatorStorageStatus_t test_boot(ActuatorControl_t *p_act)
+{
+    ActuatorStorage_t store;
+
+    test_actuator_init(p_act);
+    return actuator_storage_load(&store, p_act);
+}
+
+static ActuatorCalibRecord_t *test_slot(uint32_t index)
+{
+    return (ActuatorCalibRecord_t *)host_flash_page() + index;
+}
+
+/** CRC-32 as the record uses it (IEEE 802.3, reflected). */
+static uint32_t test_crc32(const ActuatorCalibRecord_t *p_rec)
+{
+    const uint8_t *p_data = (const uint8_t *)p_rec;
+    uint32_t       crc    = 0xFFFFFFFFUL;
+
+    for (size_t i = 0U; i < offsetof(ActuatorCalibRecord_t, crc); i++) {
+        crc ^= p_data[i];
+        for (uint8_t bit = 0U; bit < 8U; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+        }
+    }
+    return ~crc;
+}
+
+static int test_expect(const char *name, ActuatorStorageStatus_t got, ActuatorStorageStatus_t want)
+{
+    if (got != want) {
+        printf("%s: status %d, expected %d\n", name, (int)got, (int)want);
+        return 1;
+    }
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Cases                                                                    */
+/* -------------------------------------------------------------------------- */
+
+static int test_empty_page(void)
+{
+    ActuatorControl_t act;
+
+    host_hal_reset();
+    return test_expect("empty", test_boot(&act), ACTUATOR_STORAGE_EMPTY);
+}
+
+static int test_round_trip(void)
+{
+    ActuatorStorage_t store;
+    ActuatorControl_t act;
+    int               failed;
+
+    host_hal_reset();
+    failed  = test_expect("round trip save", test_save(&store, TEST_POSITION), ACTUATOR_STORAGE_OK);
+    failed |= test_expect("round trip load", test_boot(&act), ACTUATOR_STORAGE_OK);
+    if ((actuator_is_calibrated(&act) == 0U) || (actuator_get_position(&act) != TEST_POSITION)) {
+        printf("round trip: calibration not restored\n");
+        failed = 1;
+    }
+    return failed;
+}
+
+/** Power lost after the magic was programmed: the CRC does not match. */
+static int test_torn_record(void)
+{
+    ActuatorStorage_t store;
+    ActuatorControl_t act;
+    int               failed;
+
+    host_hal_reset();
+    failed = test_expect("torn save", test_save(&store, TEST_POSITION), ACTUATOR_STORAGE_OK);
+    test_slot(1U)->magic = ACTUATOR_STORAGE_MAGIC;
+    failed |= test_expect("torn", test_boot(&act), ACTUATOR_STORAGE_CORRUPT);
+    return failed;
+}
+
+static int test_version_mismatch(void)
+{
+    ActuatorStorage_t store;
+    ActuatorControl_t act;
+    int               failed;
+
+    host_hal_reset();
+    failed = test_expect("version save", test_save(&store, TEST_POSITION), ACTUATOR_STORAGE_OK);
+    test_slot(0U)->version = ACTUATOR_STORAGE_VERSION + 1U;
+    test_slot(0U)->crc     = test_crc32(test_slot(0U));
+    failed |= test_expect("version", test_boot(&act), ACTUATOR_STORAGE_VERSION_MISMATCH);
+    return failed;
+}
+
+/** Power lost while moving: the service cleared the in-motion marker. */
+static int test_stale_marker(void)
+{
+    ActuatorStorage_t store;
+    ActuatorControl_t act;
+    int               failed;
+
+    host_hal_reset();
+    test_actuator_init(&act);
+    failed = test_expect("stale load", actuator_storage_load(&store, &act), ACTUATOR_STORAGE_EMPTY);
+    actuator_restore_calibration(&act, TEST_EXTEND_TIME, TEST_SHRINK_TIME, TEST_POSITION);
+    failed |= test_expect("stale save", actuator_storage_save(&store, &act), ACTUATOR_STORAGE_OK);
+
+    actuator_extend(&act);
+    actuator_update(&act, 1U);
+    actuator_storage_service(&store, &act, 0U, 1U);
+    if (test_slot(0U)->in_motion != 0U) {
+        printf("stale: in-motion marker not programmed\n");
+        failed = 1;
+    }
+    failed |= test_expect("stale", test_boot(&act), ACTUATOR_STORAGE_STALE);
+    return failed;
+}
+
+/** A full page is erased and the record goes to the first slot. */
+static int test_page_full(void)
+{
+    ActuatorStorage_t store;
+    ActuatorControl_t act;
+    int               failed = 0;
+
+    host_hal_reset();
+    for (uint32_t i = 0U; i < TEST_PAGE_SLOTS; i++) {
+        failed |= test_expect("full fill", test_save(&store, (uint16_t)i), ACTUATOR_STORAGE_OK);
+    }
+    if (host_flash_erase_count() != 0U) {
+        printf("full: page erased before it was full\n");
+        failed = 1;
+    }
+    failed |= test_expect("full save", test_save(&store, TEST_POSITION), ACTUATOR_STORAGE_OK);
+    if ((host_flash_erase_count() != 1U) || (store.slot_addr != (uintptr_t)test_slot(0U))) {
+        printf("full: %u erases, record at slot %ld\n", (unsigned)host_flash_erase_count(),
+               (long)((ActuatorCalibRecord_t *)store.slot_addr - test_slot(0U)));
+        failed = 1;
+    }
+    failed |= test_expect("full load", test_boot(&act), ACTUATOR_STORAGE_OK);
+    if (actuator_get_position(&act) != TEST_POSITION) {
+        printf("full: position %u restored\n", (unsigned)actuator_get_position(&act));
+        failed = 1;
+    }
+    return failed;
+}
+
+/** A slot that looks free but is not erased: erase once and start over. */
+static int test_unerased_slot(void)
+{
+    ActuatorStorage_t store;
+    ActuatorControl_t act;
+    int               failed;
+
+    host_hal_reset();
+    failed = test_expect("unerased fill", test_save(&store, 100U), ACTUATOR_STORAGE_OK);
+    test_slot(1U)->crc = 0U;
+    failed |= test_expect("unerased save", test_save(&store, TEST_POSITION), ACTUATOR_STORAGE_OK);
+    if ((host_flash_erase_count() != 1U) || (store.slot_addr != (uintptr_t)test_slot(0U))) {
+        printf("unerased: %u erases, record not in slot 0\n", (unsigned)host_flash_erase_count());
+        failed = 1;
+    }
+    failed |= test_expect("unerased load", test_boot(&act), ACTUATOR_STORAGE_OK);
+    if (actuator_get_position(&act) != TEST_POSITION) {
+        printf("unerased: position %u restored\n", (unsigned)actuator_get_position(&act));
+        failed = 1;
+    }
+    return failed;
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(void)
+{
+    int failed = 0;
+
+    failed |= test_empty_page();
+    failed |= test_round_trip();
+    failed |= test_torn_record();
+    failed |= test_version_mismatch();
+    failed |= test_stale_marker();
+    failed |= test_page_full();
+    failed |= test_unerased_slot();
+
+    printf("actuator_storage_test: %s\n", (failed != 0) ? "FAILED" : "passed");
+    return failed;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file    actuator_trace_decode.c
+ * @brief   Post-mortem decoder for the #ActuatorTrace_t ring.
+ *
+ * Reads a raw image of `actuator_trace` as dumped from the target, e.g.
+ *
+ *     (gdb) dump binary value trace.bin actuator_trace
+ *
+ * or as written by `actuator_uart -D trace.bin`, and prints its records
+ * oldest first.
+ *
+ * Usage:  actuator_trace_decode [FILE]      (default: stdin)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "actuator_trace.h"
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static const char *const s_state_names[] = { "IDLE", "EXTENDING", "SHRINKING", "ERROR" };
+static const char *const s_phase_names[] = { "INIT", "EXTEND", "SHRINK", "MIDDLE" };
+static const char *const s_switch_names[] = { "extend", "shrink" };
+
+static const char *const s_command_names[] = {
+    "NONE", "EXTEND", "SHRINK", "STOP", "HOME", "MOVE", "INVALID"
+};
+
+#define NAME(table, i) (((i) < (sizeof(table) / sizeof((table)[0]))) ? (table)[i] : "?")
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static void decode_record(const ActuatorTraceRecord_t *p_rec)
+{
+    const unsigned lo = p_rec->arg & 0xFFU;
+    const unsigned hi = (unsigned)p_rec->arg >> 8U;
+
+    printf("%10u  ", (unsigned)p_rec->tick);
+    if (p_rec->actuator == 0xFFU) {
+        printf("  -  ");
+    } else {
+        printf("%3u  ", (unsigned)p_rec->actuator);
+    }
+
+    switch (p_rec->event) {
+        case ACTUATOR_TRACE_BOOT:
+            printf("boot     reset flags 0x%02X%s%s%s%s%s%s\n", lo,
+                   (lo & 0x80U) ? " LPWR" : "", (lo & 0x40U) ? " WWDG" : "",
+                   (lo & 0x20U) ? " IWDG" : "", (lo & 0x10U) ? " SFT"  : "",
+                   (lo & 0x08U) ? " POR"  : "", (lo & 0x04U) ? " PIN"  : "");
+            break;
+        case ACTUATOR_TRACE_STATE:
+            printf("state    %s -> %s\n", NAME(s_state_names, hi), NAME(s_state_names, lo));
+            break;
+        case ACTUATOR_TRACE_PHASE:
+            printf("phase    %s\n", NAME(s_phase_names, lo));
+            break;
+        case ACTUATOR_TRACE_TIMEOUT:
+            printf("timeout  homing phase %s\n", NAME(s_phase_names, lo));
+            break;
+        case ACTUATOR_TRACE_SWITCH:
+            printf("switch   %s %s\n", NAME(s_switch_names, lo), (hi != 0U) ? "pressed" : "released");
+            break;
+        case ACTUATOR_TRACE_STALL:
+            printf("stall    %s, %s\n", NAME(s_state_names, lo), (hi != 0U) ? "end stop" : "jam");
+            break;
+        default:
+            if (p_rec->event >= ACTUATOR_TRACE_COMMAND) {
+                printf("command  %s %u\n",
+                       NAME(s_command_names, (unsigned)(p_rec->event - ACTUATOR_TRACE_COMMAND)),
+                       (unsigned)p_rec->arg);
+            } else {
+                printf("event %u arg 0x%04X\n", (unsigned)p_rec->event, (unsigned)p_rec->arg);
+            }
+            break;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [trace.bin]\n", argv[0]);
+        return 1;
+    }
+
+    FILE *p_file = (argc == 2) ? fopen(argv[1], "rb") : stdin;
+    if (p_file == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    ActuatorTrace_t trace;
+    memset(&trace, 0, sizeof(trace));
+    const size_t length = fread(&trace, 1U, sizeof(trace), p_file);
+    if (p_file != stdin) {
+        fclose(p_file);
+    }
+
+    if (length != sizeof(trace)) {
+        fprintf(stderr, "short image: %zu of %zu bytes\n", length, sizeof(trace));
+        return 1;
+    }
+    if (trace.magic != ACTUATOR_TRACE_MAGIC) {
+        fprintf(stderr, "bad magic 0x%08X (trace never initialised?)\n", (unsigned)trace.magic);
+        return 1;
+    }
+
+    /* Oldest record first; only the last SIZE survive a wrap */
+    const uint32_t count = (trace.head < ACTUATOR_TRACE_SIZE) ? trace.head : ACTUATOR_TRACE_SIZE;
+    printf("# %u records (%u written)\n", (unsigned)count, (unsigned)trace.head);
+    printf("#     tick  act  event\n");
+    for (uint32_t i = trace.head - count; i != trace.head; i++) {
+        decode_record(&trace.records[i & (ACTUATOR_TRACE_SIZE - 1U)]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file    actuator_uart.c
+ * @brief   Command channel stand-in: a pseudo-terminal in place of USART1.
+ *
+ * Opens a pty and prints the path of its slave side. Every byte written to
+ * it is stored into a #UART_COMMAND_RX_SIZE byte ring exactly as the DMA
+ * channel does on the target. As in the idle-line ISR, every complete line
+ * is decoded in place and posted with actuator_post(); actuator_update()
+ * drains the queue and runs against the #ActuatorPlant_t model in real time
+ * (1 tick = 1 ms). State and position changes are logged on stdout. With
+ * `-T`, telemetry frames are written back to the pty as the target sends
+ * them on USART1 TX.
+ *
+ *     ./build-host/actuator_uart &          # prints e.g. /dev/pts/3
+ *     printf 'HOME\n' > /dev/pts/3
+ *     printf 'MOVE 250\n' > /dev/pts/3
+ *
+ * Usage:  actuator_uart [options]
+ *   -s, --stroke MM           stroke length                    (default 50)
+ *   -e, --extend-speed MM_S   extend speed                     (default 10)
+ *   -r, --shrink-speed MM_S   shrink speed                     (default 10)
+ *   -t, --time MS             exit after this long             (default: never)
+ *   -T, --telemetry MS        telemetry period, 0 = off        (default 0)
+ *   -D, --dump-trace FILE     on exit, write the #actuator_trace image to
+ *                             FILE for actuator_trace_decode
+ */
+
+#define _GNU_SOURCE                 /* posix_openpt(), cfmakeraw() */
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "actuator_command.h"
+#include "actuator_control.h"
+#include "actuator_plant.h"
+#include "actuator_telemetry.h"
+#include "actuator_trace.h"
+#include "main.h"                   /* Board pin map (EXTEND_CNTR_Pin, ...) */
+#include "uart_command.h"           /* UART_COMMAND_RX_SIZE */
+
+/* -------------------------------------------------------------------------- */
+/*   Private data                                                             */
+/* -------------------------------------------------------------------------- */
+
+static uint8_t  s_rx_ring[UART_COMMAND_RX_SIZE];    /* Written like the DMA ring */
+static uint16_t s_rx_pos;                           /* Next byte "DMA" writes     */
+static int      s_master_fd = -1;                   /* Telemetry goes back here   */
+
+static const char *const s_state_names[] = { "IDLE", "EXTENDING", "SHRINKING", "ERROR" };
+
+static const char *const s_command_names[] = {
+    "NONE", "EXTEND", "SHRINK", "STOP", "HOME", "MOVE", "INVALID"
+};
+
+/* -------------------------------------------------------------------------- */
+/*   Private helpers                                                          */
+/* -------------------------------------------------------------------------- */
+
+static uint32_t uart_now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000U) + ((uint64_t)ts.tv_nsec / 1000000U));
+}
+
+/**
+ * @brief  Open a pty master and keep its slave open in raw mode, so bytes
+ *         pass through unchanged and reads never fail when no writer is
+ *         attached.
+ * @return Master fd, or -1 on error.
+ */
+static int uart_open_pty(int *p_slave_fd)
+{
+    const int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0)) {
+        return -1;
+    }
+
+    const char *p_name = ptsname(master);
+    const int   slave  = (p_name != NULL) ? open(p_name, O_RDWR | O_NOCTTY) : -1;
+    if (slave < 0) {
+        close(master);
+        return -1;
+    }
+
+    struct termios tio;
+    if (tcgetattr(slave, &tio) == 0) {
+        cfmakeraw(&tio);
+        (void)tcsetattr(slave, TCSANOW, &tio);
+    }
+
+    printf("# command port: %s\n", p_name);
+    fflush(stdout);
+
+    *p_slave_fd = slave;
+    return master;
+}
+
+/**
+ * @brief  Copy whatever the pty holds into the ring, wrapping like circular
+ *         DMA. Old bytes are overwritten whether parsed or not.
+ */
+static void uart_receive(int master)
+{
+    uint8_t chunk[64];
+    ssize_t n;
+
+    while ((n = read(master, chunk, sizeof(chunk))) > 0) {
+        for (ssize_t i = 0; i < n; i++) {
+            s_rx_ring[s_rx_pos] = chunk[i];
+            s_rx_pos = (uint16_t)((s_rx_pos + 1U) & (UART_COMMAND_RX_SIZE - 1U));
+        }
+    }
+}
+
+/**
+ * @brief  Telemetry transmitter. A pty write completes at once, so the
+ *         caller releases the buffer right after it returns.
+ */
+static uint8_t uart_transmit(const uint8_t *p_data, uint16_t length)
+{
+    return (write(s_master_fd, p_data, length) == (ssize_t)length) ? 1U : 0U;
+}
+
+static void uart_apply_inputs(const ActuatorPlant_t *p_plant)
+{
+    host_gpio_set_input(EXTEND_SWITCH_GPIO_Port, EXTEND_SWITCH_Pin,
+                        (GPIO_PinState)p_plant->extend_switch.closed);
+    host_gpio_set_input(SHRINK_SWITCH_GPIO_Port, SHRINK_SWITCH_Pin,
+                        (GPIO_PinState)p_plant->shrink_switch.closed);
+}
+
+static void uart_apply_outputs(ActuatorPlant_t *p_plant)
+{
+    const uint32_t odr = host_gpio_get_output(EXTEND_CNTR_GPIO_Port);
+
+    actuator_plant_drive(p_plant,
+                         (uint8_t)((odr & EXTEND_CNTR_Pin) != 0U),
+                         (uint8_t)((odr & SHRINK_CNTR_Pin) != 0U));
+}
+
+static void uart_usage(const char *p_name)
+{
+    fprintf(stderr, "usage: %s [-s stroke_mm] [-e mm/s] [-r mm/s] [-t ms] [-T ms] [-D file]\n", p_name);
+}
+
+/**
+ * @brief  Write the trace ring as the debugger would dump it from the target.
+ */
+static void uart_dump_trace(const char *p_path)
+{
+#if ACTUATOR_TRACE_ENABLED
+    FILE *p_file = fopen(p_path, "wb");
+    if ((p_file == NULL) || (fwrite(&actuator_trace, sizeof(actuator_trace), 1U, p_file) != 1U)) {
+        perror(p_path);
+    }
+    if (p_file != NULL) {
+        fclose(p_file);
+    }
+#else
+    fprintf(stderr, "%s: built without ACTUATOR_TRACE_ENABLED\n", p_path);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+/*   Entry point                                                              */
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv)
+{
+    uint32_t run_ms       = 0U;
+    uint32_t telemetry_ms = 0U;
+    const char *p_trace_path = NULL;
+
+    ActuatorPlantConfig_t plant_cfg = {
+        .stroke_mm         = 50.0,
+        .extend_speed_mm_s = 10.0,
+        .shrink_speed_mm_s = 10.0,
+        .relay_delay_ms    = 8U,
+        .spinup_ms         = 0U,
+        .bounce_ms         = 2U,
+        .bounces           = 3U
+    };
+
+    static const struct option s_options[] = {
+        { "stroke",       required_argument, NULL, 's' },
+        { "extend-speed", required_argument, NULL, 'e' },
+        { "shrink-speed", required_argument, NULL, 'r' },
+        { "time",         required_argument, NULL, 't' },
+        { "telemetry",    required_argument, NULL, 'T' },
+        { "dump-trace",   required_argument, NULL, 'D' },
+        { NULL,           0,                 NULL, 0   }
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "s:e:r:t:T:D:", s_options, NULL)) != -1) {
+        switch (opt) {
+            case 's': plant_cfg.stroke_mm         = strtod(optarg, NULL);          break;
+            case 'e': plant_cfg.extend_speed_mm_s = strtod(optarg, NULL);          break;
+            case 'r': plant_cfg.shrink_speed_mm_s = strtod(optarg, NULL);          break;
+            case 't': run_ms = (uint32_t)strtoul(optarg, NULL, 0);                 break;
+            case 'T': telemetry_ms = (uint32_t)strtoul(optarg, NULL, 0);           break;
+            case 'D': p_trace_path = optarg;                                       break;
+            default:  uart_usage(argv[0]);                                         return 1;
+        }
+    }
+    if ((plant_cfg.stroke_mm <= 0.0) ||
+        (plant_cfg.extend_speed_mm_s <= 0.0) || (plant_cfg.shrink_speed_mm_s <= 0.0)) {
+        uart_usage(argv[0]);
+        return 1;
+    }
+
+    const ActuatorConfig_t act_cfg = {
+        .extend_active_level = GPIO_PIN_SET,
+        .shrink_active_level = GPIO_PIN_SET,
+        .debounce_time_ms    = MS_TO_TICKS(DEBOUNCE_TIME_MS),
+        .homing_timeout_ms   = MS_TO_TICKS(HOMING_TIMEOUT_MS),
+        .homing_margin_pct   = HOMING_TIMEOUT_MARGIN_PERCENT,
+        .relay_dead_time_ms  = MS_TO_TICKS(RELAY_DEAD_TIME_MS),
+        .stop_lag_ms         = MS_TO_TICKS(ACTUATOR_STOP_LAG_MS),
+        .park_position       = ACTUATOR_PARK_POSITION,
+        .switch_edge_wakeup  = 0U,
+
+        .extend_control_port = (void*)EXTEND_CNTR_GPIO_Port,
+        .extend_control_pin  = EXTEND_CNTR_Pin,
+        .shrink_control_port = (void*)SHRINK_CNTR_GPIO_Port,
+        .shrink_control_pin  = SHRINK_CNTR_Pin,
+        .extend_switch_port  = (void*)EXTEND_SWITCH_GPIO_Port,
+        .extend_switch_pin   = EXTEND_SWITCH_Pin,
+        .shrink_switch_port  = (void*)SHRINK_SWITCH_GPIO_Port,
+        .shrink_switch_pin   = SHRINK_SWITCH_Pin,
+        .led_extend_port     = (void*)LED_EXTEND_GPIO_Port,
+        .led_extend_pin      = LED_EXTEND_Pin,
+        .led_shrink_port     = (void*)LED_SHRINK_GPIO_Port,
+        .led_shrink_pin      = LED_SHRINK_Pin
+    };
+
+    int slave  = -1;
+    int master = uart_open_pty(&slave);
+    if (master < 0) {
+        perror("pty");
+        return 1;
+    }
+    (void)fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    s_master_fd = master;
+
+    ActuatorControl_t act;
+    ActuatorPlant_t   plant;
+    CommandParser_t   parser;
+    ActuatorTelemetry_t telemetry;
+
+    const uint32_t t0 = uart_now_ms() - 1U;     /* Tick 0 is reserved by the homing sequence */
+
+    host_hal_reset();
+#if ACTUATOR_TRACE_ENABLED
+    host_hal_set_tick(1U);
+    actuator_trace_init(0x10U);                 /* Reported as a software reset */
+#endif
+    actuator_plant_init(&plant, &plant_cfg, plant_cfg.stroke_mm / 2.0, 1U, 1U);
+    actuator_init(&act, &act_cfg);
+    (void)command_parser_init(&parser, s_rx_ring, UART_COMMAND_RX_SIZE);
+    actuator_telemetry_init(&telemetry, MS_TO_TICKS(telemetry_ms), uart_transmit, 1U);
+
+    ActuatorState_t last_state    = act.state;
+    uint16_t        last_position = act.position;
+
+    for (;;) {
+        struct pollfd pfd = { master, POLLIN, 0 };
+        (void)poll(&pfd, 1U, 1);
+
+        const uint32_t now = uart_now_ms() - t0;
+        if ((run_ms != 0U) && (now > run_ms)) {
+            break;
+        }
+
+        host_hal_set_tick(now);                 /* Trace records carry HAL_GetTick() */
+        uart_receive(master);
+
+        /* Idle-line ISR: decode every complete line and queue it */
+        ActuatorCommand_t command;
+        while (command_parser_next(&parser, s_rx_pos, &command) != 0U) {
+            if (command.type == ACTUATOR_CMD_NONE) {
+                continue;                       /* Empty line, e.g. the \n of \r\n */
+            }
+            const uint8_t queued = ((command.index == 0U) && (command.type != ACTUATOR_CMD_INVALID))
+                                   ? actuator_post(&act, &command) : 0U;
+            printf("%8u  cmd %-7s index %u arg %u%s\n", (unsigned)now,
+                   s_command_names[command.type], (unsigned)command.index,
+                   (unsigned)command.argument, (queued != 0U) ? "" : " (dropped)");
+        }
+
+        if (now > plant.now) {
+            actuator_plant_advance(&plant, now);
+        }
+        uart_apply_inputs(&plant);
+        actuator_update(&act, now);
+        actuator_telemetry_set_idle(&telemetry,
+                                    ((act.state != ACTUATOR_EXTENDING) && (act.state != ACTUATOR_SHRINKING) &&
+                                     (actuator_is_homing(&act) == 0U)) ? 1U : 0U, now);
+        actuator_telemetry_update(&telemetry, &act, 1U, now);
+        (void)actuator_telemetry_tx_done(&telemetry);
+        uart_apply_outputs(&plant);
+
+        if ((act.state != last_state) || ((act.state == ACTUATOR_IDLE) && (act.position != last_position))) {
+            last_state    = act.state;
+            last_position = act.position;
+            printf("%8u  %-9s position %u plant %.2f mm%s\n", (unsigned)now,
+                   s_state_names[act.state], (unsigned)act.position, plant.position_mm,
+                   (act.is_homing != 0U) ? " (homing)" : "");
+        }
+        fflush(stdout);
+    }
+
+    if (p_trace_path != NULL) {
+        uart_dump_trace(p_trace_path);
+    }
+
+    close(slave);
+    close(master);
+    return 0;
+}